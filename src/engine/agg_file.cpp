@@ -25,17 +25,66 @@
 #include <iterator>
 #include <string>
 
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined( TARGET_PS_VITA ) && !defined( TARGET_NINTENDO_SWITCH )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FHEROES2_AGG_MMAP
+#endif
+
+#include "logging.h"
+#include "tools.h"
+
+namespace
+{
+    const size_t fileRecordSize = sizeof( uint32_t ) * 3;
+}
+
 namespace fheroes2
 {
+    AGGFile::~AGGFile()
+    {
+        unmapFile();
+    }
+
     bool AGGFile::open( const std::string & fileName )
     {
+        _files.clear();
+
+        if ( mapFile( fileName ) ) {
+            // The size of the file has already been verified to be large enough to contain at least the number of files.
+            ROStreamBuf header( _mappedData, _mappedSize );
+
+            const size_t count = header.getLE16();
+
+            if ( count * ( fileRecordSize + _maxFilenameSize ) >= _mappedSize ) {
+                unmapFile();
+                return false;
+            }
+
+            ROStreamBuf fileEntries( _mappedData + sizeof( uint16_t ), count * fileRecordSize );
+            const size_t nameEntriesSize = _maxFilenameSize * count;
+            ROStreamBuf nameEntries( _mappedData + _mappedSize - nameEntriesSize, nameEntriesSize );
+
+            if ( !readFileEntries( fileEntries, nameEntries, count ) ) {
+                unmapFile();
+                return false;
+            }
+
+            return true;
+        }
+
         if ( !_stream.open( fileName, "rb" ) ) {
             return false;
         }
 
         const size_t size = _stream.size();
         const size_t count = _stream.getLE16();
-        const size_t fileRecordSize = sizeof( uint32_t ) * 3;
 
         if ( count * ( fileRecordSize + _maxFilenameSize ) >= size ) {
             return false;
@@ -46,11 +95,23 @@ namespace fheroes2
         _stream.seek( size - nameEntriesSize );
         ROStreamBuf nameEntries = _stream.getStreamBuf( nameEntriesSize );
 
+        if ( !readFileEntries( fileEntries, nameEntries, count ) ) {
+            return false;
+        }
+
+        return !_stream.fail();
+    }
+
+    bool AGGFile::readFileEntries( ROStreamBuf & fileEntries, ROStreamBuf & nameEntries, const size_t count )
+    {
+        FNV1aHash directoryHash;
+
         for ( size_t i = 0; i < count; ++i ) {
             std::string name = nameEntries.getString( _maxFilenameSize );
 
             // Check 32-bit filename hash.
-            if ( fileEntries.getLE32() != calculateAggFilenameHash( name ) ) {
+            const uint32_t filenameHash = fileEntries.getLE32();
+            if ( filenameHash != calculateAggFilenameHash( name ) ) {
                 // Hash check failed. AGG file is corrupted.
                 _files.clear();
                 return false;
@@ -58,6 +119,10 @@ namespace fheroes2
 
             const uint32_t fileOffset = fileEntries.getLE32();
             const uint32_t fileSize = fileEntries.getLE32();
+
+            directoryHash.update( filenameHash );
+            directoryHash.update( fileOffset );
+            directoryHash.update( fileSize );
             _files.try_emplace( std::move( name ), std::make_pair( fileSize, fileOffset ) );
         }
 
@@ -66,7 +131,9 @@ namespace fheroes2
             return false;
         }
 
-        return !_stream.fail();
+        _directoryHash = directoryHash.value();
+
+        return true;
     }
 
     std::vector<uint8_t> AGGFile::read( const std::string & fileName )
@@ -77,12 +144,136 @@ namespace fheroes2
         }
 
         const auto [fileSize, fileOffset] = it->second;
-        if ( fileSize > 0 ) {
-            _stream.seek( fileOffset );
-            return _stream.getRaw( fileSize );
+        if ( fileSize == 0 ) {
+            return {};
+        }
+
+        if ( _mappedData != nullptr ) {
+            if ( static_cast<size_t>( fileOffset ) + fileSize > _mappedSize ) {
+                return {};
+            }
+
+            return { _mappedData + fileOffset, _mappedData + fileOffset + fileSize };
+        }
+
+        _stream.seek( fileOffset );
+        return _stream.getRaw( fileSize );
+    }
+
+    ROStreamBuf AGGFile::getStreamBuf( const std::string & fileName )
+    {
+        if ( _mappedData == nullptr ) {
+            return ROStreamBuf( read( fileName ) );
+        }
+
+        auto it = _files.find( fileName );
+        if ( it == _files.end() ) {
+            return ROStreamBuf( nullptr, 0 );
+        }
+
+        const auto [fileSize, fileOffset] = it->second;
+        if ( static_cast<size_t>( fileOffset ) + fileSize > _mappedSize ) {
+            return ROStreamBuf( nullptr, 0 );
+        }
+
+        return ROStreamBuf( _mappedData + fileOffset, fileSize );
+    }
+
+    uint32_t AGGFile::getFileSize( const std::string & fileName ) const
+    {
+        auto it = _files.find( fileName );
+        if ( it == _files.end() ) {
+            return 0;
+        }
+
+        return it->second.first;
+    }
+
+    bool AGGFile::mapFile( const std::string & fileName )
+    {
+        unmapFile();
+
+#if defined( _WIN32 )
+        const HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( file == INVALID_HANDLE_VALUE ) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart <= static_cast<LONGLONG>( sizeof( uint16_t ) ) ) {
+            CloseHandle( file );
+            return false;
+        }
+
+        const HANDLE fileMapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        // The file mapping object keeps the file open by itself.
+        CloseHandle( file );
+
+        if ( fileMapping == nullptr ) {
+            return false;
         }
 
-        return {};
+        const void * data = MapViewOfFile( fileMapping, FILE_MAP_READ, 0, 0, 0 );
+        // The mapped view keeps the file mapping object alive by itself.
+        CloseHandle( fileMapping );
+
+        if ( data == nullptr ) {
+            return false;
+        }
+
+        _mappedData = static_cast<const uint8_t *>( data );
+        _mappedSize = static_cast<size_t>( fileSize.QuadPart );
+
+        return true;
+#elif defined( FHEROES2_AGG_MMAP )
+        const int file = ::open( fileName.c_str(), O_RDONLY );
+        if ( file < 0 ) {
+            return false;
+        }
+
+        struct stat fileStat;
+        if ( fstat( file, &fileStat ) != 0 || fileStat.st_size <= static_cast<off_t>( sizeof( uint16_t ) ) ) {
+            ::close( file );
+            return false;
+        }
+
+        const size_t fileSize = static_cast<size_t>( fileStat.st_size );
+
+        void * data = mmap( nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0 );
+        // The mapping keeps the file open by itself.
+        ::close( file );
+
+        if ( data == MAP_FAILED ) {
+            DEBUG_LOG( DBG_ENGINE, DBG_WARN, "Failed to memory-map file " << fileName << ", the file will be read on demand." )
+            return false;
+        }
+
+        _mappedData = static_cast<const uint8_t *>( data );
+        _mappedSize = fileSize;
+
+        return true;
+#else
+        (void)fileName;
+
+        return false;
+#endif
+    }
+
+    void AGGFile::unmapFile()
+    {
+        if ( _mappedData == nullptr ) {
+            return;
+        }
+
+#if defined( _WIN32 )
+        UnmapViewOfFile( _mappedData );
+#elif defined( FHEROES2_AGG_MMAP )
+        // The mapped memory is never modified, so casting away constness is safe here.
+        munmap( const_cast<uint8_t *>( _mappedData ), _mappedSize );
+#endif
+
+        _mappedData = nullptr;
+        _mappedSize = 0;
     }
 
     uint32_t calculateAggFilenameHash( const std::string_view str )
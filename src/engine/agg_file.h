@@ -36,19 +36,58 @@ namespace fheroes2
     class AGGFile
     {
     public:
+        AGGFile() = default;
+        AGGFile( const AGGFile & ) = delete;
+
+        ~AGGFile();
+
+        AGGFile & operator=( const AGGFile & ) = delete;
+
         bool isGood() const
         {
-            return !_stream.fail() && !_files.empty();
+            return ( _mappedData != nullptr || !_stream.fail() ) && !_files.empty();
+        }
+
+        // Returns true if the AGG file is memory-mapped, so the data of the files stored in it can be accessed without copying.
+        bool isMapped() const
+        {
+            return _mappedData != nullptr;
         }
 
+        // Opens the AGG file. If possible, the whole AGG file is memory-mapped, otherwise the data is read from the file on demand.
         bool open( const std::string & fileName );
+
         std::vector<uint8_t> read( const std::string & fileName );
 
+        // Returns a stream over the data of the given file. If the AGG file is memory-mapped, the stream refers directly to the
+        // mapped memory (so it must not outlive this object), otherwise it owns a copy of the data.
+        ROStreamBuf getStreamBuf( const std::string & fileName );
+
+        // Returns the size of the given file or 0 if there is no such file.
+        uint32_t getFileSize( const std::string & fileName ) const;
+
+        // Returns a hash of the list of files stored in the AGG file, including their sizes and offsets. It can be used to identify
+        // the AGG file without reading all of its contents.
+        uint64_t getDirectoryHash() const
+        {
+            return _directoryHash;
+        }
+
     private:
         static const size_t _maxFilenameSize = 15; // 8.3 ASCIIZ file name + 2-bytes padding
 
+        bool readFileEntries( ROStreamBuf & fileEntries, ROStreamBuf & nameEntries, const size_t count );
+
+        bool mapFile( const std::string & fileName );
+        void unmapFile();
+
         StreamFile _stream;
         std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> _files;
+
+        uint64_t _directoryHash{ 0 };
+
+        const uint8_t * _mappedData{ nullptr };
+        size_t _mappedSize{ 0 };
     };
 
     struct ICNHeader
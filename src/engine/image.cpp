@@ -26,6 +26,15 @@
 #include <cstdlib>
 #include <cstring>
 
+// SSE2 and NEON are always available on x86-64 and AArch64 platforms, so no runtime detection is needed
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define FHEROES2_IMAGE_SSE2
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+#include <arm_neon.h>
+#define FHEROES2_IMAGE_NEON
+#endif
+
 #include "image_palette.h"
 
 namespace
@@ -392,6 +401,118 @@ namespace
         return rgbToId[red + green * 64 + blue * 64 * 64];
     }
 
+    // The number of pixels which transform values are checked at once
+    const int32_t transformBlockSize = 16;
+
+    // Narrower rows are processed pixel by pixel. Most of their blocks contain both opaque and transparent pixels, so checking the blocks
+    // costs more than it saves.
+    const int32_t minTransformBlockRowWidth = 64;
+
+    enum class TransformBlockType : uint8_t
+    {
+        // All transform values are 0, so all pixels have to be copied.
+        OPAQUE,
+        // All transform values are 1, so all pixels have to be skipped.
+        TRANSPARENT,
+        // Each pixel has to be processed separately.
+        MIXED
+    };
+
+    TransformBlockType getTransformBlockType( const uint8_t * transform )
+    {
+#if defined( FHEROES2_IMAGE_SSE2 )
+        const __m128i values = _mm_loadu_si128( reinterpret_cast<const __m128i *>( transform ) );
+
+        if ( _mm_movemask_epi8( _mm_cmpeq_epi8( values, _mm_setzero_si128() ) ) == 0xFFFF ) {
+            return TransformBlockType::OPAQUE;
+        }
+
+        if ( _mm_movemask_epi8( _mm_cmpeq_epi8( values, _mm_set1_epi8( 1 ) ) ) == 0xFFFF ) {
+            return TransformBlockType::TRANSPARENT;
+        }
+#elif defined( FHEROES2_IMAGE_NEON )
+        const uint8x16_t values = vld1q_u8( transform );
+        const uint8_t maxValue = vmaxvq_u8( values );
+
+        if ( maxValue == 0 ) {
+            return TransformBlockType::OPAQUE;
+        }
+
+        if ( maxValue == 1 && vminvq_u8( values ) == 1 ) {
+            return TransformBlockType::TRANSPARENT;
+        }
+#else
+        static_assert( transformBlockSize % sizeof( uint64_t ) == 0 );
+
+        // Check 8 transform values at once using regular integer operations
+        const uint64_t transparentValues = 0x0101010101010101ULL;
+
+        bool isOpaque = true;
+        bool isTransparent = true;
+
+        for ( int32_t i = 0; i < transformBlockSize; i += static_cast<int32_t>( sizeof( uint64_t ) ) ) {
+            uint64_t values;
+            memcpy( &values, transform + i, sizeof( uint64_t ) );
+
+            isOpaque = isOpaque && ( values == 0 );
+            isTransparent = isTransparent && ( values == transparentValues );
+        }
+
+        if ( isOpaque ) {
+            return TransformBlockType::OPAQUE;
+        }
+
+        if ( isTransparent ) {
+            return TransformBlockType::TRANSPARENT;
+        }
+#endif
+
+        return TransformBlockType::MIXED;
+    }
+
+    // Processes a row of 'width' pixels of a double-layer image. Pixels are usually grouped into large areas of either fully opaque
+    // or fully transparent pixels, so transform values are checked in blocks: transparent blocks are skipped, opaque blocks are passed
+    // to 'processOpaqueBlock' and the rest of pixels are passed to 'processPixels' which has to process them one by one. Both functions
+    // receive the offset of the first pixel from the beginning of the row, 'processPixels' also receives the number of pixels.
+    // If 'isReversed' is true, then the transform values are read from right to left starting from 'transform' which is used for
+    // horizontally flipped images.
+    template <typename OpaqueBlockFunction, typename PixelsFunction>
+    void processTransformRow( const uint8_t * transform, const int32_t width, const bool isReversed, const OpaqueBlockFunction & processOpaqueBlock,
+                              const PixelsFunction & processPixels )
+    {
+        // Narrow rows are passed to 'processPixels' as a whole.
+        const int32_t blockRowWidth = ( width < minTransformBlockRowWidth ) ? 0 : width;
+
+        int32_t x = 0;
+
+        while ( x < width ) {
+            int32_t pixelCount = width - x;
+
+            if ( x + transformBlockSize <= blockRowWidth ) {
+                const uint8_t * transformBlock = isReversed ? transform - x - ( transformBlockSize - 1 ) : transform + x;
+
+                const TransformBlockType blockType = getTransformBlockType( transformBlock );
+                if ( blockType == TransformBlockType::OPAQUE ) {
+                    processOpaqueBlock( x );
+                    x += transformBlockSize;
+                    continue;
+                }
+
+                if ( blockType == TransformBlockType::TRANSPARENT ) {
+                    x += transformBlockSize;
+                    continue;
+                }
+
+                pixelCount = transformBlockSize;
+            }
+
+            // Both functions are called only from one place each so that the compiler inlines them. Otherwise the per-pixel processing
+            // becomes noticeably slower than a plain loop.
+            processPixels( x, pixelCount );
+            x += pixelCount;
+        }
+    }
+
     void ApplyRawPalette( const fheroes2::Image & in, int32_t inX, int32_t inY, fheroes2::Image & out, int32_t outX, int32_t outY, int32_t width, int32_t height,
                           const uint8_t * palette )
     {
@@ -422,16 +543,25 @@ namespace
             const uint8_t * transformInY = in.transform() + static_cast<ptrdiff_t>( inY ) * widthIn + inX;
 
             for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                const uint8_t * imageInX = imageInY;
-                const uint8_t * transformInX = transformInY;
-                uint8_t * imageOutX = imageOutY;
-                const uint8_t * imageInXEnd = imageInX + width;
-
-                for ( ; imageInX != imageInXEnd; ++imageInX, ++imageOutX, ++transformInX ) {
-                    if ( *transformInX == 0 ) { // only modify pixels with data
-                        *imageOutX = palette[*imageInX];
-                    }
-                }
+                processTransformRow(
+                    transformInY, width, false,
+                    [imageInY, imageOutY, palette]( const int32_t offset ) {
+                        for ( int32_t i = offset; i < offset + transformBlockSize; ++i ) {
+                            imageOutY[i] = palette[imageInY[i]];
+                        }
+                    },
+                    [imageInY, transformInY, imageOutY, palette]( const int32_t offset, const int32_t count ) {
+                        const uint8_t * imageInX = imageInY + offset;
+                        const uint8_t * transformInX = transformInY + offset;
+                        uint8_t * imageOutX = imageOutY + offset;
+                        const uint8_t * imageInXEnd = imageInX + count;
+
+                        for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
+                            if ( *transformInX == 0 ) { // only modify pixels with data
+                                *imageOutX = palette[*imageInX];
+                            }
+                        }
+                    } );
             }
         }
     }
@@ -514,7 +644,7 @@ namespace fheroes2
             return;
         }
 
-        const size_t size = static_cast<size_t>( width_ ) * height_ * 2;
+        const size_t size = static_cast<size_t>( width_ ) * height_ * ( _singleLayer ? 1 : 2 );
 
         _data.reset( new uint8_t[size] );
 
@@ -544,17 +674,40 @@ namespace fheroes2
         }
 
         const size_t imageSize = static_cast<size_t>( image._width ) * image._height;
+        const size_t dataSize = image._singleLayer ? imageSize : imageSize * 2;
 
-        _singleLayer = image._singleLayer;
-
-        if ( image._width != _width || image._height != _height ) {
-            _data.reset( new uint8_t[imageSize * 2] );
+        // The size of the allocated memory depends on the number of layers.
+        if ( image._width != _width || image._height != _height || image._singleLayer != _singleLayer ) {
+            _data.reset( new uint8_t[dataSize] );
 
             _width = image._width;
             _height = image._height;
         }
 
-        memcpy( _data.get(), image._data.get(), _singleLayer ? imageSize : imageSize * 2 );
+        _singleLayer = image._singleLayer;
+
+        memcpy( _data.get(), image._data.get(), dataSize );
+    }
+
+    void Image::_disableTransformLayer()
+    {
+        if ( _singleLayer ) {
+            return;
+        }
+
+        _singleLayer = true;
+
+        if ( !_data ) {
+            return;
+        }
+
+        // Release the memory occupied by the transform layer.
+        const size_t imageSize = static_cast<size_t>( _width ) * _height;
+
+        std::unique_ptr<uint8_t[]> data( new uint8_t[imageSize] );
+        memcpy( data.get(), _data.get(), imageSize );
+
+        _data = std::move( data );
     }
 
     Sprite::Sprite( Sprite && sprite ) noexcept
@@ -956,19 +1109,17 @@ namespace fheroes2
                 const uint8_t * transformInY = in.transform() + offsetInY;
 
                 for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageOutXEnd = imageOutX + width;
-
-                    for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
+                    const auto blendPixel = [imageInY, transformInY, imageOutY, gamePalette, alphaValue, behindValue]( const int32_t offset ) {
+                        const uint8_t transformValue = *( transformInY - offset );
+                        if ( transformValue == 1 ) { // skip pixel
+                            return;
                         }
 
-                        uint8_t inValue = *imageInX;
-                        if ( *transformInX > 1 ) {
-                            inValue = *( transformTable + static_cast<ptrdiff_t>( *transformInX ) * 256 + *imageOutX );
+                        uint8_t * imageOutX = imageOutY + offset;
+
+                        uint8_t inValue = *( imageInY - offset );
+                        if ( transformValue > 1 ) {
+                            inValue = *( transformTable + static_cast<ptrdiff_t>( transformValue ) * 256 + *imageOutX );
                         }
 
                         const uint8_t * inPAL = gamePalette + static_cast<ptrdiff_t>( inValue ) * 3;
@@ -978,7 +1129,20 @@ namespace fheroes2
                         const uint32_t green = static_cast<uint32_t>( *( inPAL + 1 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 1 ) ) * behindValue;
                         const uint32_t blue = static_cast<uint32_t>( *( inPAL + 2 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 2 ) ) * behindValue;
                         *imageOutX = GetPALColorId( static_cast<uint8_t>( red / 255 ), static_cast<uint8_t>( green / 255 ), static_cast<uint8_t>( blue / 255 ) );
-                    }
+                    };
+
+                    processTransformRow(
+                        transformInY, width, true,
+                        [&blendPixel]( const int32_t offset ) {
+                            for ( int32_t i = offset; i < offset + transformBlockSize; ++i ) {
+                                blendPixel( i );
+                            }
+                        },
+                        [&blendPixel]( const int32_t offset, const int32_t count ) {
+                            for ( int32_t i = offset; i < offset + count; ++i ) {
+                                blendPixel( i );
+                            }
+                        } );
                 }
             }
         }
@@ -1010,19 +1174,17 @@ namespace fheroes2
                 const uint8_t * transformInY = in.transform() + offsetInY;
 
                 for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
+                    const auto blendPixel = [imageInY, transformInY, imageOutY, gamePalette, alphaValue, behindValue]( const int32_t offset ) {
+                        const uint8_t transformValue = transformInY[offset];
+                        if ( transformValue == 1 ) { // skip pixel
+                            return;
                         }
 
-                        uint8_t inValue = *imageInX;
-                        if ( *transformInX > 1 ) {
-                            inValue = *( transformTable + static_cast<ptrdiff_t>( *transformInX ) * 256 + *imageOutX );
+                        uint8_t * imageOutX = imageOutY + offset;
+
+                        uint8_t inValue = imageInY[offset];
+                        if ( transformValue > 1 ) {
+                            inValue = *( transformTable + static_cast<ptrdiff_t>( transformValue ) * 256 + *imageOutX );
                         }
 
                         const uint8_t * inPAL = gamePalette + static_cast<ptrdiff_t>( inValue ) * 3;
@@ -1032,7 +1194,20 @@ namespace fheroes2
                         const uint32_t green = static_cast<uint32_t>( *( inPAL + 1 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 1 ) ) * behindValue;
                         const uint32_t blue = static_cast<uint32_t>( *( inPAL + 2 ) ) * alphaValue + static_cast<uint32_t>( *( outPAL + 2 ) ) * behindValue;
                         *imageOutX = GetPALColorId( static_cast<uint8_t>( red / 255 ), static_cast<uint8_t>( green / 255 ), static_cast<uint8_t>( blue / 255 ) );
-                    }
+                    };
+
+                    processTransformRow(
+                        transformInY, width, false,
+                        [&blendPixel]( const int32_t offset ) {
+                            for ( int32_t i = offset; i < offset + transformBlockSize; ++i ) {
+                                blendPixel( i );
+                            }
+                        },
+                        [&blendPixel]( const int32_t offset, const int32_t count ) {
+                            for ( int32_t i = offset; i < offset + count; ++i ) {
+                                blendPixel( i );
+                            }
+                        } );
                 }
             }
         }
@@ -1188,46 +1363,62 @@ namespace fheroes2
             if ( out.singleLayer() ) {
                 assert( !in.singleLayer() );
                 for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageOutXEnd = imageOutX + width;
-
-                    for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX ) {
-                        if ( *transformInX > 0 ) { // apply a transformation
-                            if ( *transformInX != 1 ) { // skip pixel
-                                *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
+                    processTransformRow(
+                        transformInY, width, true,
+                        [imageInY, imageOutY]( const int32_t offset ) {
+                            std::reverse_copy( imageInY - offset - ( transformBlockSize - 1 ), imageInY - offset + 1, imageOutY + offset );
+                        },
+                        [imageInY, transformInY, imageOutY]( const int32_t offset, const int32_t count ) {
+                            const uint8_t * imageInX = imageInY - offset;
+                            const uint8_t * transformInX = transformInY - offset;
+                            uint8_t * imageOutX = imageOutY + offset;
+                            const uint8_t * imageOutXEnd = imageOutX + count;
+
+                            for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX ) {
+                                if ( *transformInX > 0 ) { // apply a transformation
+                                    if ( *transformInX != 1 ) { // skip pixel
+                                        *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
+                                    }
+                                }
+                                else { // copy a pixel
+                                    *imageOutX = *imageInX;
+                                }
                             }
-                        }
-                        else { // copy a pixel
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                        } );
                 }
             }
             else {
                 uint8_t * transformOutY = out.transform() + offsetOutY;
 
                 for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-                    const uint8_t * imageOutXEnd = imageOutX + width;
-
-                    for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX, ++transformOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
-
-                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
-                            *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                        }
-                        else { // copy a pixel
-                            *transformOutX = *transformInX;
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                    processTransformRow(
+                        transformInY, width, true,
+                        [imageInY, imageOutY, transformOutY]( const int32_t offset ) {
+                            std::reverse_copy( imageInY - offset - ( transformBlockSize - 1 ), imageInY - offset + 1, imageOutY + offset );
+
+                            memset( transformOutY + offset, static_cast<uint8_t>( 0 ), transformBlockSize );
+                        },
+                        [imageInY, transformInY, imageOutY, transformOutY]( const int32_t offset, const int32_t count ) {
+                            const uint8_t * imageInX = imageInY - offset;
+                            const uint8_t * transformInX = transformInY - offset;
+                            uint8_t * imageOutX = imageOutY + offset;
+                            uint8_t * transformOutX = transformOutY + offset;
+                            const uint8_t * imageOutXEnd = imageOutX + count;
+
+                            for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX, ++transformOutX ) {
+                                if ( *transformInX == 1 ) { // skip pixel
+                                    continue;
+                                }
+
+                                if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
+                                    *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
+                                }
+                                else { // copy a pixel
+                                    *transformOutX = *transformInX;
+                                    *imageOutX = *imageInX;
+                                }
+                            }
+                        } );
                 }
             }
         }
@@ -1243,46 +1434,59 @@ namespace fheroes2
             if ( out.singleLayer() ) {
                 assert( !in.singleLayer() );
                 for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
-                        if ( *transformInX > 0 ) { // apply a transformation
-                            if ( *transformInX != 1 ) { // skip pixel
-                                *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
+                    processTransformRow(
+                        transformInY, width, false,
+                        [imageInY, imageOutY]( const int32_t offset ) { memcpy( imageOutY + offset, imageInY + offset, transformBlockSize ); },
+                        [imageInY, transformInY, imageOutY]( const int32_t offset, const int32_t count ) {
+                            const uint8_t * imageInX = imageInY + offset;
+                            const uint8_t * transformInX = transformInY + offset;
+                            uint8_t * imageOutX = imageOutY + offset;
+                            const uint8_t * imageInXEnd = imageInX + count;
+
+                            for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
+                                if ( *transformInX > 0 ) { // apply a transformation
+                                    if ( *transformInX != 1 ) { // skip pixel
+                                        *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
+                                    }
+                                }
+                                else { // copy a pixel
+                                    *imageOutX = *imageInX;
+                                }
                             }
-                        }
-                        else { // copy a pixel
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                        } );
                 }
             }
             else {
                 uint8_t * transformOutY = out.transform() + offsetOutY;
 
                 for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX, ++transformOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
-
-                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
-                            *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                        }
-                        else { // copy a pixel
-                            *transformOutX = *transformInX;
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                    processTransformRow(
+                        transformInY, width, false,
+                        [imageInY, imageOutY, transformOutY]( const int32_t offset ) {
+                            memcpy( imageOutY + offset, imageInY + offset, transformBlockSize );
+                            memset( transformOutY + offset, static_cast<uint8_t>( 0 ), transformBlockSize );
+                        },
+                        [imageInY, transformInY, imageOutY, transformOutY]( const int32_t offset, const int32_t count ) {
+                            const uint8_t * imageInX = imageInY + offset;
+                            const uint8_t * transformInX = transformInY + offset;
+                            uint8_t * imageOutX = imageOutY + offset;
+                            uint8_t * transformOutX = transformOutY + offset;
+                            const uint8_t * imageInXEnd = imageInX + count;
+
+                            for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX, ++transformOutX ) {
+                                if ( *transformInX == 1 ) { // skip pixel
+                                    continue;
+                                }
+
+                                if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
+                                    *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
+                                }
+                                else { // copy a pixel
+                                    *transformOutX = *transformInX;
+                                    *imageOutX = *imageInX;
+                                }
+                            }
+                        } );
                 }
             }
         }
@@ -1342,6 +1546,26 @@ namespace fheroes2
         uint8_t * imageOutY = out.image() + offsetOutY;
         const uint8_t * imageOutYEnd = imageOutY + height * widthOut;
 
+        if ( width == widthIn && width == widthOut ) {
+            // Rows of both images are contiguous in memory so the whole area is copied at once.
+            const size_t size = static_cast<size_t>( width ) * height;
+
+            memcpy( imageOutY, imageInY, size );
+
+            if ( out.singleLayer() ) {
+                return;
+            }
+
+            if ( in.singleLayer() ) {
+                memset( out.transform() + offsetOutY, static_cast<uint8_t>( 0 ), size );
+            }
+            else {
+                memcpy( out.transform() + offsetOutY, in.transform() + offsetInY, size );
+            }
+
+            return;
+        }
+
         if ( out.singleLayer() ) {
             for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, imageOutY += widthOut ) {
                 memcpy( imageOutY, imageInY, static_cast<size_t>( width ) );
@@ -33,6 +33,7 @@ namespace fheroes2
     // Image always contains an image layer and if image is not a single-layer then also a transform layer.
     // - image layer contains visible pixels which are copy to a destination image
     // - transform layer is used to apply some transformation to an image on which we draw the current one. For example, shadowing
+    // Single-layer images do not allocate memory for the transform layer at all.
     class Image
     {
     public:
@@ -100,8 +101,7 @@ namespace fheroes2
         // Fill 'image' layer with given value, setting 'transform' layer to 0.
         void fill( const uint8_t value );
 
-        // This is an optional indicator for image processing functions.
-        // The whole image still consists of 2 layers but transform layer might be ignored in computations
+        // Single-layer images consist only of the image layer and all their pixels are considered as opaque.
         bool singleLayer() const
         {
             return _singleLayer;
@@ -109,17 +109,15 @@ namespace fheroes2
 
         // BE CAREFUL! This method disables transform layer usage. Use only for display / video related images which are for end rendering purposes!
         // The name of this method starts from _ on purpose to do not mix with other public methods.
-        void _disableTransformLayer()
-        {
-            _singleLayer = true;
-        }
+        // Call it before resize() to avoid allocation of the transform layer, otherwise the image layer is moved to a smaller buffer.
+        void _disableTransformLayer();
 
     private:
         void copy( const Image & image );
 
         int32_t _width{ 0 };
         int32_t _height{ 0 };
-        std::unique_ptr<uint8_t[]> _data; // holds 2 image layers
+        std::unique_ptr<uint8_t[]> _data; // holds 2 image layers or only the image layer for single-layer images
 
         // Only for images which are not used for any other operations except displaying on screen.
         bool _singleLayer{ false };
@@ -346,6 +346,11 @@ namespace fheroes2
         Cursor() = default;
     };
 
+    // Makes the display use a render engine and a cursor which do not output anything, so the game can run without any video device.
+    // This function must be called before the very first call of Display::instance().
+    void enableHeadlessMode();
+    bool isHeadlessMode();
+
     BaseRenderEngine & engine();
     Cursor & cursor();
 }
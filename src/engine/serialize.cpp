@@ -29,6 +29,12 @@
 #include <string>
 #include <string_view>
 
+#if defined( _WIN32 )
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #ifdef __EMSCRIPTEN__
 #include <cstdio>
 
@@ -377,6 +383,18 @@ ROStreamBuf::ROStreamBuf( std::vector<uint8_t> && buf )
     setBigendian( IS_BIGENDIAN );
 }
 
+ROStreamBuf::ROStreamBuf( const uint8_t * data, const size_t size )
+{
+    assert( data != nullptr || size == 0 );
+
+    _itbeg = data;
+    _itend = _itbeg + size;
+    _itget = _itbeg;
+    _itput = _itend;
+
+    setBigendian( IS_BIGENDIAN );
+}
+
 std::pair<const uint8_t *, size_t> ROStreamBuf::getRawView( const size_t size /* = 0 */ )
 {
     const size_t remainSize = sizeg();
@@ -423,6 +441,31 @@ void StreamFile::close()
     _file.reset();
 }
 
+bool StreamFile::sync()
+{
+    if ( !_file ) {
+        return false;
+    }
+
+    if ( std::fflush( _file.get() ) != 0 ) {
+        setFail();
+
+        return false;
+    }
+
+#if defined( _WIN32 )
+    if ( _commit( _fileno( _file.get() ) ) != 0 ) {
+#else
+    if ( fsync( fileno( _file.get() ) ) != 0 ) {
+#endif
+        setFail();
+
+        return false;
+    }
+
+    return true;
+}
+
 size_t StreamFile::size()
 {
     if ( !_file ) {
@@ -599,6 +599,8 @@ public:
     explicit ROStreamBuf( const std::vector<uint8_t> & buf );
     // Takes ownership of the given buffer (through the move operation) and creates a stream on top of it
     explicit ROStreamBuf( std::vector<uint8_t> && buf );
+    // Creates a non-owning stream on top of an external memory area of the given size ("view mode")
+    ROStreamBuf( const uint8_t * data, const size_t size );
 
     ROStreamBuf( const ROStreamBuf & ) = delete;
 
@@ -640,6 +642,9 @@ public:
     bool open( const std::string & fn, const std::string & mode );
     void close();
 
+    // Flushes all the written data and asks the OS to write it to the storage device. Returns false on error.
+    bool sync();
+
     // If a zero size is specified, then all still unread data is returned
     ROStreamBuf getStreamBuf( const size_t size = 0 );
 
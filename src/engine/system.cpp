@@ -313,6 +313,16 @@ bool System::Unlink( const std::string_view path )
     return std::filesystem::remove( path, ec );
 }
 
+bool System::Rename( const std::string_view oldPath, const std::string_view newPath )
+{
+    std::error_code ec;
+
+    // Using the non-throwing overload
+    std::filesystem::rename( oldPath, newPath, ec );
+
+    return !ec;
+}
+
 std::string System::concatPath( const std::string_view left, const std::string_view right )
 {
     return fsPathToString( std::filesystem::path{ left }.append( right ) );
@@ -451,6 +461,36 @@ bool System::IsDirectory( const std::string_view path )
     return std::filesystem::is_directory( correctedPath, ec );
 }
 
+bool System::GetFileSizeAndModificationTime( const std::string_view path, uint64_t & size, int64_t & modificationTime )
+{
+    if ( path.empty() ) {
+        return false;
+    }
+
+    std::string correctedPath;
+    if ( !GetCaseInsensitivePath( path, correctedPath ) ) {
+        return false;
+    }
+
+    std::error_code ec;
+
+    // Using the non-throwing overloads
+    const uintmax_t fileSize = std::filesystem::file_size( correctedPath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    const std::filesystem::file_time_type fileTime = std::filesystem::last_write_time( correctedPath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    size = static_cast<uint64_t>( fileSize );
+    modificationTime = static_cast<int64_t>( fileTime.time_since_epoch().count() );
+
+    return true;
+}
+
 bool System::GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath )
 {
 #if !defined( _WIN32 ) && !defined( ANDROID ) && !defined( TARGET_PS_VITA )
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <filesystem>
 #include <string>
@@ -45,6 +46,9 @@ namespace System
     bool MakeDirectory( const std::string_view path );
     bool Unlink( const std::string_view path );
 
+    // Renames the given file, replacing the destination file if it exists. Returns false on error.
+    bool Rename( const std::string_view oldPath, const std::string_view newPath );
+
     std::string concatPath( const std::string_view left, const std::string_view right );
 
     void appendOSSpecificDirectories( std::vector<std::string> & directories );
@@ -64,6 +68,10 @@ namespace System
     bool IsFile( const std::string_view path );
     bool IsDirectory( const std::string_view path );
 
+    // Gets the size of the given file and the time of its last modification. The modification time is measured in implementation-defined
+    // units, so it can only be compared with the values returned by this function. Returns false if the file information cannot be obtained.
+    bool GetFileSizeAndModificationTime( const std::string_view path, uint64_t & size, int64_t & modificationTime );
+
     bool GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath );
 
     // Resolves the wildcard pattern 'glob' and appends matching paths to 'fileNames'. Supported wildcards are '?' and '*'.
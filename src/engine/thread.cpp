@@ -20,8 +20,10 @@
 
 #include "thread.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
+#include <vector>
 
 #if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
 namespace
@@ -150,4 +152,55 @@ namespace MultiThreading
             manager->executeTask();
         }
     }
+
+    uint32_t getWorkerCount()
+    {
+#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
+        return 1;
+#else
+        // This function is allowed to return 0 if the value is not well defined or not computable.
+        return std::max( std::thread::hardware_concurrency(), 1U );
+#endif
+    }
+
+    void parallelFor( const size_t taskCount, const uint32_t threadCount, const std::function<void( const size_t, const uint32_t )> & task )
+    {
+        assert( threadCount > 0 );
+
+#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
+        const uint32_t usedThreadCount = 1;
+#else
+        const uint32_t usedThreadCount = static_cast<uint32_t>( std::min<size_t>( threadCount, taskCount ) );
+#endif
+
+        if ( usedThreadCount <= 1 ) {
+            for ( size_t taskId = 0; taskId < taskCount; ++taskId ) {
+                task( taskId, 0 );
+            }
+
+            return;
+        }
+
+        std::atomic<size_t> nextTaskId{ 0 };
+
+        const auto processTasks = [taskCount, &task, &nextTaskId]( const uint32_t threadId ) {
+            for ( size_t taskId = nextTaskId++; taskId < taskCount; taskId = nextTaskId++ ) {
+                task( taskId, threadId );
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve( usedThreadCount - 1 );
+
+        for ( uint32_t threadId = 1; threadId < usedThreadCount; ++threadId ) {
+            threads.emplace_back( processTasks, threadId );
+        }
+
+        // The calling thread participates in the calculations too.
+        processTasks( 0 );
+
+        for ( std::thread & thread : threads ) {
+            thread.join();
+        }
+    }
 }
@@ -22,6 +22,9 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -70,4 +73,14 @@ namespace MultiThreading
 
         static void _workerThread( AsyncManager * manager );
     };
+
+    // Returns the number of threads that can be used to perform independent calculations concurrently. The returned value is at least 1.
+    uint32_t getWorkerCount();
+
+    // Calls the given function for every task index in the range [0, taskCount) using up to the specified number of threads, one
+    // of which is the calling thread. The function receives the task index and the index of the thread that executes this task
+    // (in the range [0, threadCount)), so the function can use its own per-thread data without any synchronization. Tasks are
+    // distributed between threads dynamically, so the function must not make any assumptions about the order of their execution.
+    // This call returns only after all tasks are completed.
+    void parallelFor( const size_t taskCount, const uint32_t threadCount, const std::function<void( const size_t, const uint32_t )> & task );
 }
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <charconv>
 #include <cstdlib>
 #include <cstring>
 #include <limits>
@@ -177,4 +178,10 @@ namespace fheroes2
 
         str.append( std::to_string( mod ) );
     }
+
+    bool parseNumber( const std::string_view str, uint32_t & number )
+    {
+        const auto [ptr, ec] = std::from_chars( str.data(), str.data() + str.size(), number );
+        return ec == std::errc() && ptr == str.data() + str.size();
+    }
 }
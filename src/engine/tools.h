@@ -82,6 +82,27 @@ namespace fheroes2
 {
     uint32_t calculateCRC32( const uint8_t * data, const size_t length );
 
+    // Calculates 64-bit FNV-1a hash of a sequence of 32-bit values. Every value is hashed byte by byte starting from the least significant byte.
+    class FNV1aHash
+    {
+    public:
+        void update( const uint32_t value )
+        {
+            for ( uint32_t i = 0; i < 4; ++i ) {
+                _hash ^= ( value >> ( i * 8 ) ) & 0xFF;
+                _hash *= 1099511628211ULL;
+            }
+        }
+
+        uint64_t value() const
+        {
+            return _hash;
+        }
+
+    private:
+        uint64_t _hash{ 14695981039346656037ULL };
+    };
+
     template <size_t N>
     std::bitset<N> makeBitsetFromVector( const std::vector<int> & vector )
     {
@@ -99,6 +120,10 @@ namespace fheroes2
     // Appends the given modifier to the end of the given string (e.g. "Coliseum +2")
     void appendModifierToString( std::string & str, const int mod );
 
+    // Parses the given string as an unsigned decimal number. Returns false if the string is not such a number (including the case
+    // when there are any characters after the number) or if the number does not fit into uint32_t.
+    bool parseNumber( const std::string_view str, uint32_t & number );
+
     // Performs case-insensitive string comparison, suitable for string sorting purposes. Returns true if the first parameter is
     // "less than" the second, otherwise returns false.
     template <typename CharType>
@@ -1,6 +1,6 @@
 /***************************************************************************
  *   fheroes2: https://github.com/ihhub/fheroes2                           *
- *   Copyright (C) 2019 - 2024                                             *
+ *   Copyright (C) 2019 - 2026                                             *
  *                                                                         *
  *   Free Heroes2 Engine: http://sourceforge.net/projects/fheroes2         *
  *   Copyright (C) 2009 by Andrey Afletdinov <fheroes2@gmail.com>          *
@@ -23,7 +23,9 @@
 
 #include "zzlib.h"
 
+#include <cassert>
 #include <cstring>
+#include <limits>
 #include <ostream>
 
 #include <zconf.h>
@@ -35,8 +37,72 @@
 namespace
 {
     constexpr uint16_t FORMAT_VERSION_0 = 0;
+
+    // Size of the buffers used to zip the data on the fly.
+    constexpr size_t zipChunkSize = 64 * 1024;
+
+    int getZlibLevel( const Compression::Level level )
+    {
+        switch ( level ) {
+        case Compression::Level::FAST:
+            return Z_BEST_SPEED;
+        case Compression::Level::DEFAULT:
+            return Z_DEFAULT_COMPRESSION;
+        case Compression::Level::BEST:
+            return Z_BEST_COMPRESSION;
+        default:
+            // Did you add a new compression level? Add the logic above!
+            assert( 0 );
+            break;
+        }
+
+        return Z_DEFAULT_COMPRESSION;
+    }
+
+    // Every codec used for zipped chunks must be supported by these two functions.
+    std::vector<uint8_t> zipWithCodec( const Compression::Codec codec, const Compression::Level level, const uint8_t * src, const size_t srcSize )
+    {
+        switch ( codec ) {
+        case Compression::Codec::ZLIB:
+            return Compression::zipData( src, srcSize, level );
+        default:
+            // Did you add a new codec? Add the logic above!
+            assert( 0 );
+            break;
+        }
+
+        return {};
+    }
+
+    std::vector<uint8_t> unzipWithCodec( const Compression::Codec codec, const uint8_t * src, const size_t srcSize, const size_t realSize )
+    {
+        switch ( codec ) {
+        case Compression::Codec::ZLIB:
+            return Compression::unzipData( src, srcSize, realSize );
+        default:
+            // This chunk was zipped by a newer version of the game or it is corrupted.
+            ERROR_LOG( "Unsupported compression codec: " << static_cast<uint16_t>( codec ) )
+            break;
+        }
+
+        return {};
+    }
+
+    void writeZipChunkHeader( OStreamBase & outputStream, const uint32_t rawSize, const uint32_t zipSize, const Compression::Codec codec )
+    {
+        outputStream.put32( rawSize );
+        outputStream.put32( zipSize );
+        outputStream.put16( FORMAT_VERSION_0 );
+        outputStream.put16( static_cast<uint16_t>( codec ) );
+    }
 }
 
+struct Compression::ZipFileOStream::ZStream
+{
+    z_stream stream{};
+    bool isInitialized{ false };
+};
+
 std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t srcSize, size_t realSize /* = 0 */ )
 {
     if ( src == nullptr || srcSize == 0 ) {
@@ -100,7 +166,7 @@ std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t s
     return res;
 }
 
-std::vector<uint8_t> Compression::zipData( const uint8_t * src, const size_t srcSize )
+std::vector<uint8_t> Compression::zipData( const uint8_t * src, const size_t srcSize, const Level level /* = Level::DEFAULT */ )
 {
     if ( src == nullptr || srcSize == 0 ) {
         return {};
@@ -120,7 +186,7 @@ std::vector<uint8_t> Compression::zipData( const uint8_t * src, const size_t src
         return {};
     }
 
-    const int ret = compress( res.data(), &dstSizeULong, src, srcSizeULong );
+    const int ret = compress2( res.data(), &dstSizeULong, src, srcSizeULong, getZlibLevel( level ) );
 
     if ( ret != Z_OK ) {
         ERROR_LOG( "zlib error: " << ret )
@@ -145,10 +211,10 @@ bool Compression::unzipStream( IStreamBase & inputStream, OStreamBase & outputSt
         return false;
     }
 
-    inputStream.skip( 2 ); // Unused bytes
+    const Codec codec = static_cast<Codec>( inputStream.get16() );
 
     const std::vector<uint8_t> zip = inputStream.getRaw( zipSize );
-    const std::vector<uint8_t> raw = unzipData( zip.data(), zip.size(), rawSize );
+    const std::vector<uint8_t> raw = unzipWithCodec( codec, zip.data(), zip.size(), rawSize );
     if ( raw.size() != rawSize ) {
         return false;
     }
@@ -158,22 +224,203 @@ bool Compression::unzipStream( IStreamBase & inputStream, OStreamBase & outputSt
     return !outputStream.fail();
 }
 
-bool Compression::zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream )
+bool Compression::zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream, const Codec codec /* = Codec::ZLIB */,
+                                const Level level /* = Level::DEFAULT */ )
 {
-    const std::vector<uint8_t> zip = zipData( inputStream.data(), inputStream.size() );
+    const std::vector<uint8_t> zip = zipWithCodec( codec, level, inputStream.data(), inputStream.size() );
     if ( zip.empty() ) {
         return false;
     }
 
-    outputStream.put32( static_cast<uint32_t>( inputStream.size() ) );
-    outputStream.put32( static_cast<uint32_t>( zip.size() ) );
-    outputStream.put16( FORMAT_VERSION_0 );
-    outputStream.put16( 0 ); // Unused bytes
+    writeZipChunkHeader( outputStream, static_cast<uint32_t>( inputStream.size() ), static_cast<uint32_t>( zip.size() ), codec );
     outputStream.putRaw( zip.data(), zip.size() );
 
     return !outputStream.fail();
 }
 
+Compression::ZipFileOStream::ZipFileOStream( StreamFile & fileStream, const Level level /* = Level::DEFAULT */ )
+    : _fileStream( fileStream )
+    , _zStream( std::make_unique<ZStream>() )
+{
+    setBigendian( _fileStream.bigendian() );
+
+    _inputBuffer.reserve( zipChunkSize );
+    _outputBuffer.resize( zipChunkSize );
+
+    _headerPos = _fileStream.tell();
+
+    // The sizes are not known yet, they will be written by finish().
+    writeZipChunkHeader( _fileStream, 0, 0, Codec::ZLIB );
+    if ( _fileStream.fail() ) {
+        setFail();
+        return;
+    }
+
+    // This is what the deflateInit() macro expands to, but without the C-style cast.
+    const int ret = deflateInit_( &_zStream->stream, getZlibLevel( level ), ZLIB_VERSION, static_cast<int>( sizeof( z_stream ) ) );
+    if ( ret != Z_OK ) {
+        ERROR_LOG( "zlib error: " << ret )
+        setFail();
+        return;
+    }
+
+    _zStream->isInitialized = true;
+}
+
+Compression::ZipFileOStream::~ZipFileOStream()
+{
+    if ( _zStream->isInitialized ) {
+        deflateEnd( &_zStream->stream );
+    }
+}
+
+void Compression::ZipFileOStream::putBE16( uint16_t v )
+{
+    put8( static_cast<uint8_t>( v >> 8 ) );
+    put8( static_cast<uint8_t>( v ) );
+}
+
+void Compression::ZipFileOStream::putLE16( uint16_t v )
+{
+    put8( static_cast<uint8_t>( v ) );
+    put8( static_cast<uint8_t>( v >> 8 ) );
+}
+
+void Compression::ZipFileOStream::putBE32( uint32_t v )
+{
+    put8( static_cast<uint8_t>( v >> 24 ) );
+    put8( static_cast<uint8_t>( v >> 16 ) );
+    put8( static_cast<uint8_t>( v >> 8 ) );
+    put8( static_cast<uint8_t>( v ) );
+}
+
+void Compression::ZipFileOStream::putLE32( uint32_t v )
+{
+    put8( static_cast<uint8_t>( v ) );
+    put8( static_cast<uint8_t>( v >> 8 ) );
+    put8( static_cast<uint8_t>( v >> 16 ) );
+    put8( static_cast<uint8_t>( v >> 24 ) );
+}
+
+void Compression::ZipFileOStream::putRaw( const void * ptr, size_t size )
+{
+    assert( !_isFinished );
+
+    const uint8_t * data = static_cast<const uint8_t *>( ptr );
+
+    while ( size > 0 && !fail() ) {
+        const size_t sizeToCopy = std::min( size, zipChunkSize - _inputBuffer.size() );
+
+        _inputBuffer.insert( _inputBuffer.end(), data, data + sizeToCopy );
+
+        data += sizeToCopy;
+        size -= sizeToCopy;
+
+        if ( _inputBuffer.size() == zipChunkSize ) {
+            deflateInput( false );
+        }
+    }
+}
+
+void Compression::ZipFileOStream::put8( const uint8_t v )
+{
+    assert( !_isFinished );
+
+    if ( fail() ) {
+        return;
+    }
+
+    _inputBuffer.push_back( v );
+
+    if ( _inputBuffer.size() == zipChunkSize ) {
+        deflateInput( false );
+    }
+}
+
+void Compression::ZipFileOStream::deflateInput( const bool isLastInput )
+{
+    assert( _zStream->isInitialized );
+
+    z_stream & stream = _zStream->stream;
+
+    stream.next_in = _inputBuffer.data();
+    stream.avail_in = static_cast<uInt>( _inputBuffer.size() );
+
+    const int flush = isLastInput ? Z_FINISH : Z_NO_FLUSH;
+
+    int ret = Z_OK;
+
+    // Compressed data is written out every time the output buffer is full.
+    do {
+        stream.next_out = _outputBuffer.data();
+        stream.avail_out = static_cast<uInt>( _outputBuffer.size() );
+
+        ret = deflate( &stream, flush );
+        if ( ret == Z_STREAM_ERROR ) {
+            ERROR_LOG( "zlib error: " << ret )
+            setFail();
+            return;
+        }
+
+        const size_t zipSize = _outputBuffer.size() - stream.avail_out;
+
+        _fileStream.putRaw( _outputBuffer.data(), zipSize );
+        if ( _fileStream.fail() ) {
+            setFail();
+            return;
+        }
+
+        _zipSize += zipSize;
+    } while ( stream.avail_out == 0 );
+
+    assert( stream.avail_in == 0 );
+
+    if ( isLastInput && ret != Z_STREAM_END ) {
+        ERROR_LOG( "zlib error: " << ret )
+        setFail();
+        return;
+    }
+
+    _rawSize += _inputBuffer.size();
+    _inputBuffer.clear();
+}
+
+bool Compression::ZipFileOStream::finish()
+{
+    assert( !_isFinished );
+
+    _isFinished = true;
+
+    if ( fail() ) {
+        return false;
+    }
+
+    deflateInput( true );
+    if ( fail() ) {
+        return false;
+    }
+
+    if ( _rawSize > std::numeric_limits<uint32_t>::max() || _zipSize > std::numeric_limits<uint32_t>::max() ) {
+        ERROR_LOG( "The size of the data is too large" )
+        setFail();
+        return false;
+    }
+
+    // Write the actual sizes to the header of the zipped chunk.
+    const size_t endPos = _fileStream.tell();
+
+    _fileStream.seek( _headerPos );
+    writeZipChunkHeader( _fileStream, static_cast<uint32_t>( _rawSize ), static_cast<uint32_t>( _zipSize ), Codec::ZLIB );
+    _fileStream.seek( endPos );
+
+    if ( _fileStream.fail() ) {
+        setFail();
+        return false;
+    }
+
+    return true;
+}
+
 fheroes2::Image Compression::CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer )
 {
     if ( imageData == nullptr || imageSize == 0 || width <= 0 || height <= 0 ) {
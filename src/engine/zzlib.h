@@ -1,6 +1,6 @@
 /***************************************************************************
  *   fheroes2: https://github.com/ihhub/fheroes2                           *
- *   Copyright (C) 2019 - 2025                                             *
+ *   Copyright (C) 2019 - 2026                                             *
  *                                                                         *
  *   Free Heroes2 Engine: http://sourceforge.net/projects/fheroes2         *
  *   Copyright (C) 2009 by Andrey Afletdinov <fheroes2@gmail.com>          *
@@ -25,24 +25,40 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "image.h"
-
-class IStreamBase;
-class OStreamBase;
-class IStreamBuf;
+#include "serialize.h"
 
 namespace Compression
 {
+    // Compression methods of zipped chunks. The method used is stored in the header of every zipped chunk, so the values of
+    // this enumeration must never be changed. Zipped chunks written before the method was stored always have the ZLIB value.
+    enum class Codec : uint16_t
+    {
+        ZLIB = 0
+    };
+
+    // Trade-offs between the speed of zipping and the compression ratio. Zipped data can be unzipped regardless of the level
+    // it was zipped with.
+    enum class Level : uint8_t
+    {
+        // The fastest zipping at the cost of the compression ratio, for data which is written often, like autosaves.
+        FAST,
+        DEFAULT,
+        // The best compression ratio at the cost of the zipping speed, for data which is stored for a long time.
+        BEST
+    };
+
     // Unzips the input data and returns the uncompressed data or an empty vector in case of an error.
     // The 'realSize' parameter represents the planned size of the decompressed data and is optional
     // (it is only used to speed up the decompression process). If this parameter is omitted or set to
     // zero, the size of the decompressed data will be determined automatically.
     std::vector<uint8_t> unzipData( const uint8_t * src, const size_t srcSize, size_t realSize = 0 );
 
-    // Zips the input data and returns the compressed data or an empty vector in case of an error.
-    std::vector<uint8_t> zipData( const uint8_t * src, const size_t srcSize );
+    // Zips the input data in the zlib format and returns the compressed data or an empty vector in case of an error.
+    std::vector<uint8_t> zipData( const uint8_t * src, const size_t srcSize, const Level level = Level::DEFAULT );
 
     // Reads & unzips the zipped chunk from the given input stream and writes it to the given output
     // stream. Returns true on success or false on error.
@@ -51,7 +67,55 @@ namespace Compression
     // Zips the contents of the buffer from the current read position to the end of the buffer and writes
     // it to the given output stream. The current read position of the buffer does not change. Returns
     // true on success and false on error.
-    bool zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream );
+    bool zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream, const Codec codec = Codec::ZLIB, const Level level = Level::DEFAULT );
+
+    // Stream that zips the data written to it on the fly and writes the zipped data directly to the given file stream, so the
+    // unzipped data is never kept in memory as a whole. The zipped chunk has the same format as the one written by zipStreamBuf()
+    // and can be read using unzipStream(). The ZLIB codec is always used. The byte order of the file stream is used by default.
+    // The writing must be completed by calling finish(), otherwise the zipped chunk remains incomplete.
+    class ZipFileOStream final : public OStreamBase
+    {
+    public:
+        explicit ZipFileOStream( StreamFile & fileStream, const Level level = Level::DEFAULT );
+
+        ZipFileOStream( const ZipFileOStream & ) = delete;
+
+        ~ZipFileOStream() override;
+
+        ZipFileOStream & operator=( const ZipFileOStream & ) = delete;
+
+        void putBE16( uint16_t v ) override;
+        void putLE16( uint16_t v ) override;
+        void putBE32( uint32_t v ) override;
+        void putLE32( uint32_t v ) override;
+
+        void putRaw( const void * ptr, size_t size ) override;
+
+        // Zips the rest of the data, writes it to the file stream and updates the header of the zipped chunk. Nothing can be
+        // written to this stream after that. Returns true on success and false on error.
+        bool finish();
+
+    private:
+        struct ZStream;
+
+        void put8( const uint8_t v ) override;
+
+        // Zips the data accumulated in the input buffer and writes the zipped data to the file stream.
+        void deflateInput( const bool isLastInput );
+
+        StreamFile & _fileStream;
+
+        std::unique_ptr<ZStream> _zStream;
+
+        std::vector<uint8_t> _inputBuffer;
+        std::vector<uint8_t> _outputBuffer;
+
+        size_t _headerPos{ 0 };
+        uint64_t _rawSize{ 0 };
+        uint64_t _zipSize{ 0 };
+
+        bool _isFinished{ false };
+    };
 
     fheroes2::Image CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer );
 }
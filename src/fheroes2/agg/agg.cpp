@@ -22,11 +22,13 @@
  ***************************************************************************/
 
 #include <list>
+#include <mutex>
 #include <stdexcept>
 #include <utility>
 
 #include "agg.h"
 #include "agg_file.h"
+#include "agg_image.h"
 #include "dir.h"
 #include "settings.h"
 #include "tools.h"
@@ -35,10 +37,15 @@ namespace
 {
     fheroes2::AGGFile heroes2_agg;
     fheroes2::AGGFile heroes2x_agg;
+
+    // AGG files can be accessed by the resource preloading thread, and if an AGG file is not memory-mapped, reading from it modifies its state.
+    std::mutex aggFileMutex;
 }
 
 std::vector<uint8_t> AGG::getDataFromAggFile( const std::string & key, const bool ignoreExpansion )
 {
+    const std::scoped_lock<std::mutex> lock( aggFileMutex );
+
     if ( !ignoreExpansion && heroes2x_agg.isGood() ) {
         // Make sure that the below container is not const and not a reference
         // so returning it from the function will invoke a move constructor instead of copy constructor.
@@ -50,6 +57,30 @@ std::vector<uint8_t> AGG::getDataFromAggFile( const std::string & key, const boo
     return heroes2_agg.read( key );
 }
 
+ROStreamBuf AGG::getDataStreamFromAggFile( const std::string & key, const bool ignoreExpansion )
+{
+    const std::scoped_lock<std::mutex> lock( aggFileMutex );
+
+    if ( !ignoreExpansion && heroes2x_agg.isGood() && heroes2x_agg.getFileSize( key ) > 0 ) {
+        return heroes2x_agg.getStreamBuf( key );
+    }
+
+    return heroes2_agg.getStreamBuf( key );
+}
+
+uint64_t AGG::getAggFilesHash()
+{
+    const std::scoped_lock<std::mutex> lock( aggFileMutex );
+
+    uint64_t hash = heroes2_agg.getDirectoryHash();
+
+    if ( heroes2x_agg.isGood() ) {
+        hash ^= heroes2x_agg.getDirectoryHash() + 0x9e3779b97f4a7c15ULL + ( hash << 6 ) + ( hash >> 2 );
+    }
+
+    return hash;
+}
+
 AGG::AGGInitializer::AGGInitializer()
 {
     if ( init() ) {
@@ -59,6 +90,11 @@ AGG::AGGInitializer::AGGInitializer()
     throw std::logic_error( "No AGG data files found." );
 }
 
+AGG::AGGInitializer::~AGGInitializer()
+{
+    fheroes2::AGG::stopResourcePreloading();
+}
+
 bool AGG::AGGInitializer::init()
 {
     const ListFiles aggFileNames = Settings::FindFiles( "data", ".agg", false );
@@ -27,6 +27,8 @@
 #include <string>
 #include <vector>
 
+#include "serialize.h"
+
 namespace AGG
 {
     class AGGInitializer
@@ -36,7 +38,7 @@ namespace AGG
         AGGInitializer( const AGGInitializer & ) = delete;
         AGGInitializer & operator=( const AGGInitializer & ) = delete;
 
-        ~AGGInitializer() = default;
+        ~AGGInitializer();
 
         const std::string & getOriginalAGGFilePath() const
         {
@@ -56,4 +58,11 @@ namespace AGG
     };
 
     std::vector<uint8_t> getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
+
+    // Returns a value identifying the contents of the AGG files in use.
+    uint64_t getAggFilesHash();
+
+    // Returns a stream over the data of the given file stored in the AGG files. If the AGG file is memory-mapped, the stream refers
+    // directly to the mapped memory without copying the data, so it must not be used after the AGG files are closed.
+    ROStreamBuf getDataStreamFromAggFile( const std::string & key, const bool ignoreExpansion );
 }
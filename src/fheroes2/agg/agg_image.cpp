@@ -24,9 +24,14 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <initializer_list>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <set>
 #include <stdexcept>
@@ -43,11 +48,15 @@
 #include "icn.h"
 #include "image.h"
 #include "image_tool.h"
+#include "logging.h"
 #include "math_base.h"
 #include "pal.h"
 #include "rand.h"
 #include "screen.h"
 #include "serialize.h"
+#include "settings.h"
+#include "sprite_cache.h"
+#include "thread.h"
 #include "til.h"
 #include "tools.h"
 #include "translations.h"
@@ -69,6 +78,36 @@ namespace
 
     std::map<int, std::vector<fheroes2::Sprite>> _icnVsScaledSprite;
 
+    // The access generation is increased every time unused resources are evicted from memory.
+    // Each ICN and TIL remembers the generation during which it was accessed last time.
+    uint32_t _accessGeneration = 1;
+    std::vector<uint32_t> _icnLastAccessGeneration( ICN::LASTICN, 0 );
+    std::array<uint32_t, TIL::LASTTIL> _tilLastAccessGeneration{};
+
+    // These ICNs are never evicted from memory. Fonts are generated at runtime and cannot be reloaded from AGG files,
+    // while the control panel buttons and the battle text bar are referenced by the game interface for a long time.
+    const std::set<int> pinnedIcnId{ ICN::FONT,
+                                     ICN::SMALFONT,
+                                     ICN::BUTTON_GOOD_FONT_RELEASED,
+                                     ICN::BUTTON_GOOD_FONT_PRESSED,
+                                     ICN::BUTTON_EVIL_FONT_RELEASED,
+                                     ICN::BUTTON_EVIL_FONT_PRESSED,
+                                     ICN::YELLOW_FONT,
+                                     ICN::YELLOW_SMALLFONT,
+                                     ICN::GRAY_FONT,
+                                     ICN::GRAY_SMALL_FONT,
+                                     ICN::WHITE_LARGE_FONT,
+                                     ICN::GOLDEN_GRADIENT_FONT,
+                                     ICN::GOLDEN_GRADIENT_LARGE_FONT,
+                                     ICN::SILVER_GRADIENT_FONT,
+                                     ICN::SILVER_GRADIENT_LARGE_FONT,
+                                     ICN::ADVBTNS,
+                                     ICN::ADVEBTNS,
+                                     ICN::TEXTBAR };
+
+    // Some ICNs are generated together and modify each other while being loaded. They can be evicted only all at once.
+    const std::vector<std::vector<int>> linkedIcnIds{ { ICN::MINIMON, ICN::MINI_MONSTER_IMAGE, ICN::MINI_MONSTER_SHADOW } };
+
     // Some resources are language dependent. These are mostly buttons with a text of them.
     // Once a user changes a language we have to update resources. To do this we need to clear the existing images.
 
@@ -212,6 +251,47 @@ namespace
         return id >= 0 && static_cast<size_t>( id ) < _tilVsImage.size();
     }
 
+    template <typename T>
+    size_t getImagesMemorySize( const std::vector<T> & images )
+    {
+        size_t size = images.capacity() * sizeof( T );
+
+        for ( const T & image : images ) {
+            // Single-layer images do not hold the transform layer.
+            size += static_cast<size_t>( image.width() ) * image.height() * ( image.singleLayer() ? 1 : 2 );
+        }
+
+        return size;
+    }
+
+    size_t getIcnMemorySize( const int id )
+    {
+        size_t size = getImagesMemorySize( _icnVsSprite[id] );
+
+        if ( const auto iter = _icnVsScaledSprite.find( id ); iter != _icnVsScaledSprite.end() ) {
+            size += getImagesMemorySize( iter->second );
+        }
+
+        return size;
+    }
+
+    size_t getTilMemorySize( const int id )
+    {
+        size_t size = 0;
+
+        for ( const std::vector<fheroes2::Image> & images : _tilVsImage[id] ) {
+            size += getImagesMemorySize( images );
+        }
+
+        return size;
+    }
+
+    void unloadIcn( const int id )
+    {
+        std::vector<fheroes2::Sprite>().swap( _icnVsSprite[id] );
+        _icnVsScaledSprite.erase( id );
+    }
+
     fheroes2::Image createDigit( const int32_t width, const int32_t height, const std::vector<fheroes2::Point> & points, const uint8_t pixelColor )
     {
         fheroes2::Image digit( width, height );
@@ -527,8 +607,8 @@ namespace
 
     void replacePOLAssetWithSW( const int id, const int assetIndex )
     {
-        const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), true );
-        ROStreamBuf imageStream( body );
+        ROStreamBuf imageStream = ::AGG::getDataStreamFromAggFile( ICN::getIcnFileName( id ), true );
+        const uint8_t * body = imageStream.data();
 
         imageStream.seek( headerSize + assetIndex * 13 );
 
@@ -539,39 +619,39 @@ namespace
         imageStream >> header2;
         const uint32_t dataSize = header2.offsetData - header1.offsetData;
 
-        const uint8_t * data = body.data() + headerSize + header1.offsetData;
+        const uint8_t * data = body + headerSize + header1.offsetData;
         const uint8_t * dataEnd = data + dataSize;
 
         _icnVsSprite[id][assetIndex] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
     }
 
-    // This function returns true if sprites were successfully loaded from AGG file.
-    // WARNING: this function must be called once - only in the beginning of `loadICN()` function.
-    bool readIcnFromAgg( const int id )
+    // Decodes all sprites of the given ICN from AGG file using up to the given number of threads. Returns true if sprites were
+    // successfully decoded. This function does not access any shared state except the AGG files, so it can be called from any thread.
+    bool decodeIcnFromAgg( const int id, std::vector<fheroes2::Sprite> & sprites, const uint32_t threadCount )
     {
-        // If this assertion blows up then something wrong with your logic and you load resources more than once!
-        assert( _icnVsSprite[id].empty() );
+        // The data is decoded directly from the memory-mapped AGG file when possible, without making a copy of it.
+        ROStreamBuf imageStream = ::AGG::getDataStreamFromAggFile( ICN::getIcnFileName( id ), false );
 
-        const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
+        const uint8_t * body = imageStream.data();
+        const size_t bodySize = imageStream.size();
 
-        if ( body.empty() ) {
+        if ( bodySize == 0 ) {
             return false;
         }
 
-        ROStreamBuf imageStream( body );
-
         const uint32_t count = imageStream.getLE16();
         const uint32_t blockSize = imageStream.getLE32();
         if ( count == 0 || blockSize == 0 ) {
             return false;
         }
 
-        _icnVsSprite[id].resize( count );
+        std::vector<fheroes2::ICNHeader> headers( count );
+        std::vector<std::pair<const uint8_t *, const uint8_t *>> dataRanges( count );
 
         for ( uint32_t i = 0; i < count; ++i ) {
             imageStream.seek( headerSize + i * 13 );
 
-            fheroes2::ICNHeader header1;
+            fheroes2::ICNHeader & header1 = headers[i];
             imageStream >> header1;
 
             // There should be enough frames for ICNs with animation. When animationFrames is equal to 32 then it is a Monochromatic image
@@ -587,22 +667,417 @@ namespace
                 dataSize = blockSize - header1.offsetData;
             }
 
-            if ( headerSize + header1.offsetData + dataSize > body.size() ) {
+            if ( headerSize + header1.offsetData + dataSize > bodySize ) {
                 // This is a corrupted AGG file.
                 throw fheroes2::InvalidDataResources( "ICN Id " + std::to_string( id ) + ", index " + std::to_string( i )
                                                       + " is being corrupted. "
                                                         "Make sure that you own an official version of the game." );
             }
 
-            const uint8_t * data = body.data() + headerSize + header1.offsetData;
-            const uint8_t * dataEnd = data + dataSize;
+            const uint8_t * data = body + headerSize + header1.offsetData;
+            dataRanges[i] = { data, data + dataSize };
+        }
+
+        sprites.resize( count );
+
+        MultiThreading::parallelFor( count, threadCount, [&sprites, &headers, &dataRanges]( const size_t i, const uint32_t /* threadId */ ) {
+            sprites[i] = fheroes2::decodeICNSprite( dataRanges[i].first, dataRanges[i].second, headers[i] );
+        } );
+
+        return true;
+    }
+
+    // Decodes all images of the given TIL from AGG file together with their flipped variants using up to the given number of threads.
+    // This function does not access any shared state except the AGG files, so it can be called from any thread.
+    void decodeTilFromAgg( const int id, std::vector<std::vector<fheroes2::Image>> & tilImages, const uint32_t threadCount )
+    {
+        tilImages.resize( 4 ); // 4 possible sides
+
+        ROStreamBuf buffer = ::AGG::getDataStreamFromAggFile( tilFileName[id], false );
+
+        const uint8_t * data = buffer.data();
+        const size_t dataSize = buffer.size();
+
+        if ( dataSize < headerSize ) {
+            // The important resource is absent! Make sure that you are using the correct version of the game.
+            assert( 0 );
+            return;
+        }
+
+        const size_t count = buffer.getLE16();
+        const int32_t width = buffer.getLE16();
+        const int32_t height = buffer.getLE16();
+        if ( count < 1 || width < 1 || height < 1 || ( headerSize + count * width * height ) != dataSize ) {
+            return;
+        }
+
+        std::vector<fheroes2::Image> & originalTIL = tilImages[0];
+        decodeTILImages( data + headerSize, count, width, height, originalTIL );
+
+        for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
+            tilImages[shapeId].resize( count );
+        }
+
+        MultiThreading::parallelFor( count, threadCount, [&tilImages, &originalTIL, width, height]( const size_t i, const uint32_t /* threadId */ ) {
+            for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
+                fheroes2::Image & image = tilImages[shapeId][i];
+
+                const bool horizontalFlip = ( shapeId & 2 ) != 0;
+                const bool verticalFlip = ( shapeId & 1 ) != 0;
+
+                image._disableTransformLayer();
+                image.resize( width, height );
+
+                Flip( originalTIL[i], 0, 0, image, 0, 0, width, height, horizontalFlip, verticalFlip );
+            }
+        } );
+    }
+
+    // Decodes ICN and TIL resources in the background before they are requested, so opening a new screen does not have to wait for
+    // all the resources used by this screen to be decoded. Only the decoding of original resources from AGG files is performed in the
+    // background, all further processing of decoded images (which may require access to other resources) is done by the main thread.
+    class ResourcePreloader final : public MultiThreading::AsyncManager
+    {
+    public:
+        void push( const std::vector<int> & icnIds, const std::vector<int> & tilIds )
+        {
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            for ( const int id : icnIds ) {
+                addTask( ResourceType::ICN, id );
+            }
+
+            for ( const int id : tilIds ) {
+                addTask( ResourceType::TIL, id );
+            }
+
+            notifyWorker();
+        }
+
+        // Retrieves the sprites of the given ICN decoded in the background. If this ICN is being decoded at the moment, waits for the
+        // decoding to complete. If the decoding of this ICN has not started yet, it is canceled. Returns false if there are no decoded
+        // sprites of this ICN, so it should be decoded by the caller.
+        bool takeIcn( const int id, std::vector<fheroes2::Sprite> & sprites )
+        {
+            return takeResult( ResourceType::ICN, id, _icnResults, sprites );
+        }
+
+        // Same as takeIcn() but for the images of the given TIL.
+        bool takeTil( const int id, std::vector<std::vector<fheroes2::Image>> & images )
+        {
+            return takeResult( ResourceType::TIL, id, _tilResults, images );
+        }
+
+        // Returns the amount of memory in bytes occupied by the decoded resources which have not been taken yet.
+        size_t getResultMemorySize()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            size_t size = 0;
+
+            for ( const auto & [id, result] : _icnResults ) {
+                size += getImagesMemorySize( result.images );
+            }
+
+            for ( const auto & [id, result] : _tilResults ) {
+                for ( const std::vector<fheroes2::Image> & images : result.images ) {
+                    size += getImagesMemorySize( images );
+                }
+            }
+
+            return size;
+        }
+
+        // Removes the decoded resources which have not been taken since the previous call of this method, since they are most likely
+        // not going to be requested anymore.
+        void removeStaleResults()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            removeStaleResults( _icnResults );
+            removeStaleResults( _tilResults );
+        }
+
+    private:
+        enum class ResourceType : uint8_t
+        {
+            ICN,
+            TIL
+        };
+
+        enum class TaskState : uint8_t
+        {
+            Pending,
+            InProgress,
+            Completed
+        };
+
+        using Task = std::pair<ResourceType, int>;
+
+        template <typename T>
+        struct Result
+        {
+            T images;
+
+            // Whether this result has already been kept during a call of removeStaleResults().
+            bool isStale{ false };
+        };
+
+        // Tasks which are not taken by the worker thread yet.
+        std::deque<Task> _tasks;
+
+        // All tasks taken by the worker thread at once are decoded in a single batch using all available threads. The batch is modified
+        // only by the worker thread while the _mutex is acquired, so the worker thread can read it without locking.
+        std::vector<Task> _batch;
+
+        // States of the tasks in the batch, accessed only while the _mutex is acquired.
+        std::vector<TaskState> _batchTaskStates;
+
+        std::map<int, Result<std::vector<fheroes2::Sprite>>> _icnResults;
+        std::map<int, Result<std::vector<std::vector<fheroes2::Image>>>> _tilResults;
+
+        std::condition_variable _resultNotification;
+
+        // This method is called by the main thread and the _mutex should be acquired while calling it
+        void addTask( const ResourceType type, const int id )
+        {
+            const Task task{ type, id };
+
+            if ( getBatchTaskState( task ) != TaskState::Completed || std::find( _tasks.begin(), _tasks.end(), task ) != _tasks.end() ) {
+                return;
+            }
+
+            if ( type == ResourceType::ICN ? _icnResults.count( id ) > 0 : _tilResults.count( id ) > 0 ) {
+                return;
+            }
+
+            _tasks.push_back( task );
+        }
+
+        // Returns the state of the given task in the current batch. Tasks absent in the batch are considered completed. The _mutex
+        // should be acquired while calling this method.
+        TaskState getBatchTaskState( const Task & task ) const
+        {
+            const auto iter = std::find( _batch.begin(), _batch.end(), task );
+            if ( iter == _batch.end() ) {
+                return TaskState::Completed;
+            }
+
+            return _batchTaskStates[static_cast<size_t>( iter - _batch.begin() )];
+        }
+
+        template <typename T>
+        bool takeResult( const ResourceType type, const int id, std::map<int, Result<T>> & results, T & output )
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            const Task task{ type, id };
+
+            // It is faster to decode the resource right away than to wait for the decoding of other resources.
+            const auto taskIter = std::find( _tasks.begin(), _tasks.end(), task );
+            if ( taskIter != _tasks.end() ) {
+                _tasks.erase( taskIter );
+                return false;
+            }
+
+            const auto batchIter = std::find( _batch.begin(), _batch.end(), task );
+            if ( batchIter != _batch.end() ) {
+                TaskState & state = _batchTaskStates[static_cast<size_t>( batchIter - _batch.begin() )];
+                if ( state == TaskState::Pending ) {
+                    state = TaskState::Completed;
+                    return false;
+                }
+            }
+
+            _resultNotification.wait( lock, [this, &task] { return getBatchTaskState( task ) != TaskState::InProgress; } );
+
+            const auto resultIter = results.find( id );
+            if ( resultIter == results.end() ) {
+                return false;
+            }
+
+            output = std::move( resultIter->second.images );
+            results.erase( resultIter );
+
+            return true;
+        }
+
+        template <typename T>
+        static void removeStaleResults( std::map<int, Result<T>> & results )
+        {
+            for ( auto iter = results.begin(); iter != results.end(); ) {
+                if ( iter->second.isStale ) {
+                    iter = results.erase( iter );
+                }
+                else {
+                    iter->second.isStale = true;
+                    ++iter;
+                }
+            }
+        }
+
+        bool prepareTask() override
+        {
+            _batch.assign( _tasks.begin(), _tasks.end() );
+            _batchTaskStates.assign( _batch.size(), TaskState::Pending );
+
+            _tasks.clear();
+
+            return false;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            if ( _batch.empty() ) {
+                // Nothing to do.
+                return;
+            }
+
+            // Every resource is decoded by a single thread, so the threads are created only once for the whole batch.
+            MultiThreading::parallelFor( _batch.size(), MultiThreading::getWorkerCount(),
+                                         [this]( const size_t taskId, const uint32_t /* threadId */ ) { executeBatchTask( taskId ); } );
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _batch.clear();
+                _batchTaskStates.clear();
+            }
+        }
+
+        void executeBatchTask( const size_t taskId )
+        {
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                if ( _batchTaskStates[taskId] != TaskState::Pending ) {
+                    // The task has been canceled.
+                    return;
+                }
+
+                _batchTaskStates[taskId] = TaskState::InProgress;
+            }
+
+            const auto [type, id] = _batch[taskId];
+
+            std::vector<fheroes2::Sprite> sprites;
+            std::vector<std::vector<fheroes2::Image>> images;
+            bool isDecoded = true;
+
+            try {
+                if ( type == ResourceType::ICN ) {
+                    isDecoded = decodeIcnFromAgg( id, sprites, 1 );
+                }
+                else {
+                    decodeTilFromAgg( id, images, 1 );
+                }
+            }
+            catch ( const std::exception & ) {
+                // The main thread will decode this resource again and will report the error.
+                isDecoded = false;
+            }
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                if ( isDecoded ) {
+                    if ( type == ResourceType::ICN ) {
+                        _icnResults.try_emplace( id, Result<std::vector<fheroes2::Sprite>>{ std::move( sprites ) } );
+                    }
+                    else {
+                        _tilResults.try_emplace( id, Result<std::vector<std::vector<fheroes2::Image>>>{ std::move( images ) } );
+                    }
+                }
+
+                _batchTaskStates[taskId] = TaskState::Completed;
+            }
+
+            _resultNotification.notify_all();
+        }
+    };
+
+    ResourcePreloader resourcePreloader;
+
+    // ICNs generated by generateAlphabet() and generateButtonAlphabet() functions.
+    const std::array<int, 6> generatedAlphabetIcnIds = { ICN::FONT,
+                                                        ICN::SMALFONT,
+                                                        ICN::BUTTON_GOOD_FONT_RELEASED,
+                                                        ICN::BUTTON_GOOD_FONT_PRESSED,
+                                                        ICN::BUTTON_EVIL_FONT_RELEASED,
+                                                        ICN::BUTTON_EVIL_FONT_PRESSED };
+
+    // The cache key depends on the language even for the original alphabet, so every language has its own cache file. Otherwise switching
+    // between languages using the original alphabet would overwrite the same file again and again.
+    std::string getGeneratedAlphabetCacheName( const fheroes2::SupportedLanguage language, const bool isOriginalAlphabet )
+    {
+        return std::string( "alphabet_" ) + fheroes2::getLanguageAbbreviation( language ) + ( isOriginalAlphabet ? "_original" : "" );
+    }
+
+    // Must be increased every time the code generating the alphabets is changed. The game version alone is not enough for this since
+    // it is not changed between releases.
+    const uint32_t generatedAlphabetFormatVersion = 1;
+
+    // Generated alphabets depend on the original alphabet stored in AGG files, the code of the game and the language.
+    std::string getGeneratedAlphabetCacheKey( const fheroes2::SupportedLanguage language, const bool isOriginalAlphabet )
+    {
+        return Settings::GetVersion() + '|' + std::to_string( generatedAlphabetFormatVersion ) + '|' + std::to_string( ::AGG::getAggFilesHash() ) + '|'
+               + fheroes2::getLanguageAbbreviation( language ) + '|' + ( isOriginalAlphabet ? "original" : "generated" );
+    }
 
-            _icnVsSprite[id][i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
+    bool loadGeneratedAlphabetFromCache( const fheroes2::SupportedLanguage language, const bool isOriginalAlphabet )
+    {
+        std::map<int, std::vector<fheroes2::Sprite>> icnVsSprite;
+        if ( !fheroes2::loadSpriteCache( getGeneratedAlphabetCacheName( language, isOriginalAlphabet ), getGeneratedAlphabetCacheKey( language, isOriginalAlphabet ),
+                                         icnVsSprite ) ) {
+            return false;
+        }
+
+        if ( std::any_of( generatedAlphabetIcnIds.begin(), generatedAlphabetIcnIds.end(), [&icnVsSprite]( const int id ) { return icnVsSprite[id].empty(); } ) ) {
+            return false;
+        }
+
+        for ( const int id : generatedAlphabetIcnIds ) {
+            _icnVsSprite[id] = std::move( icnVsSprite[id] );
+        }
+
+        // Fonts derived from the alphabet have to be generated again.
+        for ( const int id : { ICN::YELLOW_FONT, ICN::YELLOW_SMALLFONT, ICN::GRAY_FONT, ICN::GRAY_SMALL_FONT, ICN::WHITE_LARGE_FONT, ICN::GOLDEN_GRADIENT_FONT,
+                               ICN::GOLDEN_GRADIENT_LARGE_FONT, ICN::SILVER_GRADIENT_FONT, ICN::SILVER_GRADIENT_LARGE_FONT } ) {
+            _icnVsSprite[id].clear();
         }
 
         return true;
     }
 
+    void saveGeneratedAlphabetToCache( const fheroes2::SupportedLanguage language, const bool isOriginalAlphabet )
+    {
+        std::map<int, std::vector<fheroes2::Sprite>> icnVsSprite;
+        for ( const int id : generatedAlphabetIcnIds ) {
+            icnVsSprite.try_emplace( id, _icnVsSprite[id] );
+        }
+
+        fheroes2::saveSpriteCache( getGeneratedAlphabetCacheName( language, isOriginalAlphabet ), getGeneratedAlphabetCacheKey( language, isOriginalAlphabet ),
+                                   icnVsSprite );
+    }
+
+    // This function returns true if sprites were successfully loaded from AGG file.
+    // WARNING: this function must be called once - only in the beginning of `loadICN()` function.
+    bool readIcnFromAgg( const int id )
+    {
+        // If this assertion blows up then something wrong with your logic and you load resources more than once!
+        assert( _icnVsSprite[id].empty() );
+
+        // The ICN might have been already decoded in the background.
+        if ( resourcePreloader.takeIcn( id, _icnVsSprite[id] ) ) {
+            return !_icnVsSprite[id].empty();
+        }
+
+        return decodeIcnFromAgg( id, _icnVsSprite[id], 1 );
+    }
+
     // Helper function for processICN
     void CopyICNWithPalette( const int icnId, const int originalIcnId, const PAL::PaletteType paletteType )
     {
@@ -1527,7 +2002,7 @@ namespace
         }
         case ICN::BUTTONS_NEW_GAME_MENU_GOOD: {
             // Set the size depending on whether PoL assets are present or not, in which case add 4 more for campaign buttons.
-            const bool isPoLPresent = !::AGG::getDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).empty();
+            const bool isPoLPresent = ::AGG::getDataStreamFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).size() > 0;
             if ( isPoLPresent ) {
                 _icnVsSprite[id].resize( 28 );
             }
@@ -1953,7 +2428,7 @@ namespace
     {
         switch ( id ) {
         case ICN::BUTTONS_NEW_GAME_MENU_GOOD: {
-            const bool isPoLPresent = !::AGG::getDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).empty();
+            const bool isPoLPresent = ::AGG::getDataStreamFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).size() > 0;
             if ( isPoLPresent ) {
                 _icnVsSprite[id].resize( 28 );
             }
@@ -2173,7 +2648,7 @@ namespace
     {
         switch ( id ) {
         case ICN::BUTTONS_NEW_GAME_MENU_GOOD: {
-            const bool isPoLPresent = !::AGG::getDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).empty();
+            const bool isPoLPresent = ::AGG::getDataStreamFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).size() > 0;
             if ( isPoLPresent ) {
                 _icnVsSprite[id].resize( 28 );
             }
@@ -2341,7 +2816,7 @@ namespace
                 throw std::logic_error( "The game resources are corrupted. Please use resources from a licensed version of Heroes of Might and Magic II." );
             }
 
-            const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
+            const ROStreamBuf body = ::AGG::getDataStreamFromAggFile( ICN::getIcnFileName( id ), false );
             const uint32_t crc32 = fheroes2::calculateCRC32( body.data(), body.size() );
 
             if ( id == ICN::SMALFONT ) {
@@ -3174,8 +3649,8 @@ namespace
                 _icnVsSprite[id].resize( 18 );
 
                 // Make empty buttons for object types.
-                _icnVsSprite[id][6].resize( 27, 27 );
                 _icnVsSprite[id][6]._disableTransformLayer();
+                _icnVsSprite[id][6].resize( 27, 27 );
                 _icnVsSprite[id][6].reset();
                 Fill( _icnVsSprite[id][6], 1, 1, 24, 24, 65U );
                 for ( size_t i = 7; i < _icnVsSprite[id].size(); ++i ) {
@@ -3300,7 +3775,7 @@ namespace
 
                 // Since we cannot access game settings from here we are checking an existence
                 // of one of POL resources as an indicator for this version.
-                if ( !::AGG::getDataFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).empty() ) {
+                if ( ::AGG::getDataStreamFromAggFile( ICN::getIcnFileName( ICN::X_TRACK1 ), false ).size() > 0 ) {
                     fheroes2::Sprite editorIcon;
                     fheroes2::h2d::readImage( "main_menu_editor_icon.image", editorIcon );
 
@@ -4161,9 +4636,10 @@ namespace
                 // This fixes "Arm of the Martyr" (#88) and " Sphere of Negation" (#99) artifacts rendering which initially has some incorrect transparent pixels.
                 for ( const int32_t index : { 88, 99 } ) {
                     fheroes2::Sprite & originalImage = _icnVsSprite[id][index];
-                    fheroes2::Sprite temp( originalImage.width(), originalImage.height() );
-                    temp.setPosition( originalImage.x(), originalImage.y() );
+                    fheroes2::Sprite temp;
                     temp._disableTransformLayer();
+                    temp.resize( originalImage.width(), originalImage.height() );
+                    temp.setPosition( originalImage.x(), originalImage.y() );
                     temp.fill( 0 );
                     Blit( originalImage, temp );
                     originalImage = std::move( temp );
@@ -4986,9 +5462,9 @@ namespace
             _icnVsSprite[id].resize( 1 );
 
             fheroes2::Sprite & background = _icnVsSprite[id][0];
+            background._disableTransformLayer();
             background.resize( 65, 65 );
             fheroes2::Copy( fheroes2::AGG::GetICN( ICN::ESPANBKG, 0 ), 69, 47, background, 0, 0, 65, 65 );
-            background._disableTransformLayer();
 
             break;
         }
@@ -5354,44 +5830,12 @@ namespace
         auto & tilImages = _tilVsImage[id];
 
         if ( tilImages.empty() ) {
-            tilImages.resize( 4 ); // 4 possible sides
-
-            const std::vector<uint8_t> & data = ::AGG::getDataFromAggFile( tilFileName[id], false );
-            if ( data.size() < headerSize ) {
-                // The important resource is absent! Make sure that you are using the correct version of the game.
-                assert( 0 );
-                return 0;
-            }
-
-            ROStreamBuf buffer( data );
-
-            const size_t count = buffer.getLE16();
-            const int32_t width = buffer.getLE16();
-            const int32_t height = buffer.getLE16();
-            if ( count < 1 || width < 1 || height < 1 || ( headerSize + count * width * height ) != data.size() ) {
-                return 0;
-            }
-
-            std::vector<fheroes2::Image> & originalTIL = tilImages[0];
-            decodeTILImages( data.data() + headerSize, count, width, height, originalTIL );
-
-            for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
-                tilImages[shapeId].resize( count );
+            // The TIL might have been already decoded in the background.
+            if ( !resourcePreloader.takeTil( id, tilImages ) ) {
+                decodeTilFromAgg( id, tilImages, 1 );
             }
 
-            for ( size_t i = 0; i < count; ++i ) {
-                for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
-                    fheroes2::Image & image = tilImages[shapeId][i];
-
-                    const bool horizontalFlip = ( shapeId & 2 ) != 0;
-                    const bool verticalFlip = ( shapeId & 1 ) != 0;
-
-                    image._disableTransformLayer();
-                    image.resize( width, height );
-
-                    Flip( originalTIL[i], 0, 0, image, 0, 0, width, height, horizontalFlip, verticalFlip );
-                }
-            }
+            assert( tilImages.size() == 4 );
         }
 
         return tilImages[0].size();
@@ -5455,6 +5899,38 @@ namespace
 
         return resizedIcn;
     }
+
+#if defined( WITH_DEBUG )
+    // Writes the memory usage of every loaded ICN and TIL into the log.
+    void logResourceMemoryUsage()
+    {
+        std::vector<std::pair<size_t, int>> icnSizes;
+
+        for ( int id = ICN::UNKNOWN + 1; id < ICN::LASTICN; ++id ) {
+            const size_t size = getIcnMemorySize( id );
+            if ( size > 0 ) {
+                icnSizes.emplace_back( size, id );
+            }
+        }
+
+        std::sort( icnSizes.begin(), icnSizes.end(), std::greater<>() );
+
+        for ( const auto & [size, id] : icnSizes ) {
+            DEBUG_LOG( DBG_GAME, DBG_TRACE,
+                       "ICN " << id << " (" << ICN::getIcnFileName( id ) << "): " << size << " bytes, last access generation " << _icnLastAccessGeneration[id]
+                              << ( pinnedIcnId.count( id ) > 0 ? ", pinned" : "" ) )
+        }
+
+        for ( int id = 0; id < TIL::LASTTIL; ++id ) {
+            const size_t size = getTilMemorySize( id );
+            if ( size > 0 ) {
+                DEBUG_LOG( DBG_GAME, DBG_TRACE, "TIL " << tilFileName[id] << ": " << size << " bytes, last access generation " << _tilLastAccessGeneration[id] )
+            }
+        }
+
+        DEBUG_LOG( DBG_GAME, DBG_TRACE, "Loaded images occupy " << fheroes2::AGG::getResourceMemoryUsage() << " bytes, current access generation is " << _accessGeneration )
+    }
+#endif
 }
 
 namespace fheroes2::AGG
@@ -5465,6 +5941,8 @@ namespace fheroes2::AGG
             return errorImage;
         }
 
+        _icnLastAccessGeneration[icnId] = _accessGeneration;
+
         if ( index >= GetMaximumICNIndex( icnId ) ) {
             return errorImage;
         }
@@ -5476,12 +5954,47 @@ namespace fheroes2::AGG
         return _icnVsSprite[icnId][index];
     }
 
+    void preloadResources( const std::vector<int> & icnIds, const std::vector<int> & tilIds )
+    {
+        std::vector<int> icnIdsToLoad;
+        icnIdsToLoad.reserve( icnIds.size() );
+
+        for ( const int id : icnIds ) {
+            // Only original ICNs can be decoded in the background.
+            if ( IsValidICNId( id ) && id < ICN::LAST_VALID_FILE_ICN && !isLanguageDependentIcnId( id ) && _icnVsSprite[id].empty() ) {
+                icnIdsToLoad.push_back( id );
+            }
+        }
+
+        std::vector<int> tilIdsToLoad;
+        tilIdsToLoad.reserve( tilIds.size() );
+
+        for ( const int id : tilIds ) {
+            if ( IsValidTILId( id ) && _tilVsImage[id].empty() ) {
+                tilIdsToLoad.push_back( id );
+            }
+        }
+
+        if ( icnIdsToLoad.empty() && tilIdsToLoad.empty() ) {
+            return;
+        }
+
+        resourcePreloader.push( icnIdsToLoad, tilIdsToLoad );
+    }
+
+    void stopResourcePreloading()
+    {
+        resourcePreloader.stopWorker();
+    }
+
     uint32_t GetICNCount( int icnId )
     {
         if ( !IsValidICNId( icnId ) ) {
             return 0;
         }
 
+        _icnLastAccessGeneration[icnId] = _accessGeneration;
+
         return static_cast<uint32_t>( GetMaximumICNIndex( icnId ) );
     }
 
@@ -5495,6 +6008,8 @@ namespace fheroes2::AGG
             return errorImage;
         }
 
+        _tilLastAccessGeneration[tilId] = _accessGeneration;
+
         const size_t maxTILIndex = GetMaximumTILIndex( tilId );
         if ( index >= maxTILIndex ) {
             return errorImage;
@@ -5503,6 +6018,142 @@ namespace fheroes2::AGG
         return _tilVsImage[tilId][shapeId][index];
     }
 
+    size_t getResourceMemoryUsage()
+    {
+        size_t size = 0;
+
+        for ( int id = ICN::UNKNOWN + 1; id < ICN::LASTICN; ++id ) {
+            size += getIcnMemorySize( id );
+        }
+
+        for ( int id = 0; id < TIL::LASTTIL; ++id ) {
+            size += getTilMemorySize( id );
+        }
+
+        // The resources decoded in the background are going to be loaded soon.
+        size += resourcePreloader.getResultMemorySize();
+
+        return size;
+    }
+
+    void evictUnusedResources( const size_t memoryLimit )
+    {
+        const uint32_t currentGeneration = _accessGeneration;
+
+        // All resources accessed from now on are considered as recently used.
+        ++_accessGeneration;
+
+        resourcePreloader.removeStaleResults();
+
+        if ( memoryLimit == 0 ) {
+            // There is no limit.
+            return;
+        }
+
+        size_t usedMemory = getResourceMemoryUsage();
+        if ( usedMemory <= memoryLimit ) {
+            return;
+        }
+
+        // A group of resources which can be evicted only all at once.
+        struct EvictionCandidate
+        {
+            uint32_t lastAccessGeneration{ 0 };
+            size_t size{ 0 };
+            std::vector<int> icnIds;
+            int tilId{ -1 };
+        };
+
+        std::vector<EvictionCandidate> candidates;
+        std::vector<bool> isIcnProcessed( _icnVsSprite.size(), false );
+
+        const auto addIcnCandidate = [&candidates, &isIcnProcessed, currentGeneration]( const std::vector<int> & icnIds ) {
+            for ( const int id : icnIds ) {
+                isIcnProcessed[id] = true;
+            }
+
+            EvictionCandidate candidate;
+
+            for ( const int id : icnIds ) {
+                if ( pinnedIcnId.count( id ) > 0 ) {
+                    return;
+                }
+
+                candidate.lastAccessGeneration = std::max( candidate.lastAccessGeneration, _icnLastAccessGeneration[id] );
+                candidate.size += getIcnMemorySize( id );
+            }
+
+            // Resources accessed since the previous eviction can still be referenced by the game interface.
+            if ( candidate.size > 0 && candidate.lastAccessGeneration < currentGeneration ) {
+                candidate.icnIds = icnIds;
+                candidates.emplace_back( std::move( candidate ) );
+            }
+        };
+
+        for ( const std::vector<int> & icnIds : linkedIcnIds ) {
+            addIcnCandidate( icnIds );
+        }
+
+        for ( int id = ICN::UNKNOWN + 1; id < ICN::LASTICN; ++id ) {
+            if ( !isIcnProcessed[id] ) {
+                addIcnCandidate( { id } );
+            }
+        }
+
+        for ( int id = 0; id < TIL::LASTTIL; ++id ) {
+            const size_t size = getTilMemorySize( id );
+            if ( size > 0 && _tilLastAccessGeneration[id] < currentGeneration ) {
+                EvictionCandidate candidate;
+                candidate.lastAccessGeneration = _tilLastAccessGeneration[id];
+                candidate.size = size;
+                candidate.tilId = id;
+
+                candidates.emplace_back( std::move( candidate ) );
+            }
+        }
+
+        // The least recently used resources are evicted first. Among resources which were used during the same generation
+        // bigger ones are evicted first to unload as few resources as possible.
+        std::sort( candidates.begin(), candidates.end(), []( const EvictionCandidate & first, const EvictionCandidate & second ) {
+            if ( first.lastAccessGeneration != second.lastAccessGeneration ) {
+                return first.lastAccessGeneration < second.lastAccessGeneration;
+            }
+
+            return first.size > second.size;
+        } );
+
+        size_t evictedCount = 0;
+
+        for ( const EvictionCandidate & candidate : candidates ) {
+            if ( usedMemory <= memoryLimit ) {
+                break;
+            }
+
+            for ( const int id : candidate.icnIds ) {
+                unloadIcn( id );
+            }
+
+            if ( candidate.tilId >= 0 ) {
+                std::vector<std::vector<fheroes2::Image>>().swap( _tilVsImage[candidate.tilId] );
+            }
+
+            usedMemory -= candidate.size;
+            ++evictedCount;
+        }
+
+        DEBUG_LOG( DBG_GAME, DBG_INFO, "Evicted " << evictedCount << " resource groups, images occupy " << usedMemory << " bytes now, the limit is " << memoryLimit << " bytes" )
+
+#if defined( WITH_DEBUG )
+        if ( IS_DEBUG( DBG_GAME, DBG_TRACE ) ) {
+            logResourceMemoryUsage();
+        }
+#endif
+
+        if ( usedMemory > memoryLimit ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Recently used images occupy more memory than the limit of " << memoryLimit << " bytes" )
+        }
+    }
+
     void updateLanguageDependentResources( const SupportedLanguage language, const bool loadOriginalAlphabet )
     {
         static bool areOriginalResourcesInUse = false;
@@ -5534,11 +6185,17 @@ namespace fheroes2::AGG
             alphabetPreserver.preserve();
             // Restore original letters when changing language to avoid changes to them being carried over.
             alphabetPreserver.restore();
-
-            generateAlphabet( language, _icnVsSprite );
         }
 
-        generateButtonAlphabet( language, _icnVsSprite );
+        if ( !loadGeneratedAlphabetFromCache( language, loadOriginalResources ) ) {
+            if ( !loadOriginalResources ) {
+                generateAlphabet( language, _icnVsSprite );
+            }
+
+            generateButtonAlphabet( language, _icnVsSprite );
+
+            saveGeneratedAlphabetToCache( language, loadOriginalResources );
+        }
 
         // Clear language dependent resources.
         for ( const int id : languageDependentIcnId ) {
@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace fheroes2
 {
@@ -37,6 +39,22 @@ namespace fheroes2
         // shapeId could be 0, 1, 2 or 3 only
         const Image & GetTIL( int tilId, uint32_t index, uint32_t shapeId );
 
+        // Starts decoding of the given ICN and TIL resources in the background, so they are ready by the time they are requested.
+        // GetICN() and GetTIL() wait only for the resources that are being decoded at the moment of the call.
+        void preloadResources( const std::vector<int> & icnIds, const std::vector<int> & tilIds );
+
+        // Stops the background decoding of resources. This function must be called before AGG files are closed.
+        void stopResourcePreloading();
+
+        // Returns the amount of memory in bytes occupied by all loaded ICN and TIL images.
+        size_t getResourceMemoryUsage();
+
+        // Unloads the least recently used ICNs and TILs until the memory occupied by images fits into the given limit in bytes (0 means no limit).
+        // Only the resources not accessed since the previous call of this function are unloaded and fonts together with some frequently used
+        // interface elements are never unloaded. WARNING: this function must be called only at the moments when no references to images
+        // are being held, like at the beginning of a turn.
+        void evictUnusedResources( const size_t memoryLimit );
+
         // This function must be called only at the time of setting up a new language.
         void updateLanguageDependentResources( const SupportedLanguage language, const bool loadOriginalAlphabet );
     }
@@ -58,7 +58,9 @@ namespace
                 return mapIterator->second;
             }
 
-            Bin_Info::MonsterAnimInfo info( monsterID, AGG::getDataFromAggFile( GetFilename( monsterID ), false ) );
+            const ROStreamBuf data = AGG::getDataStreamFromAggFile( GetFilename( monsterID ), false );
+
+            Bin_Info::MonsterAnimInfo info( monsterID, data.data(), data.size() );
             if ( info.isValid() ) {
                 _animMap[monsterID] = info;
                 return info;
@@ -85,14 +87,12 @@ namespace Bin_Info
     const double SHOOT_SPEED_UPGRADE = 0.08;
     const double RANGER_SHOOT_SPEED = 0.78;
 
-    MonsterAnimInfo::MonsterAnimInfo( const int monsterID /* = 0 */, const std::vector<uint8_t> & bytes /* = std::vector<uint8_t>() */ )
+    MonsterAnimInfo::MonsterAnimInfo( const int monsterID /* = 0 */, const uint8_t * data /* = nullptr */, const size_t size /* = 0 */ )
     {
-        if ( bytes.size() != Bin_Info::CORRECT_FRM_LENGTH ) {
+        if ( data == nullptr || size != Bin_Info::CORRECT_FRM_LENGTH ) {
             return;
         }
 
-        const uint8_t * data = bytes.data();
-
         eyePosition = { getValue<int16_t>( data, 1 ), getValue<int16_t>( data, 3 ) };
 
         for ( size_t moveID = 0; moveID < 7; ++moveID ) {
@@ -84,7 +84,7 @@ namespace Bin_Info
         uint32_t idleAnimationDelay{ 0 };
         std::vector<std::vector<int>> animationFrames;
 
-        MonsterAnimInfo( const int monsterID = 0, const std::vector<uint8_t> & bytes = std::vector<uint8_t>() );
+        MonsterAnimInfo( const int monsterID = 0, const uint8_t * data = nullptr, const size_t size = 0 );
 
         bool hasAnim( const size_t animID = MonsterAnimInfo::STATIC ) const
         {
@@ -0,0 +1,236 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "sprite_cache.h"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "game_io.h"
+#include "image.h"
+#include "logging.h"
+#include "serialize.h"
+#include "system.h"
+
+namespace
+{
+    // "FH2S" in little-endian byte order
+    const uint32_t cacheFileMagic = 0x53324846;
+
+    // Must be increased every time the format of the cache file is changed.
+    const uint16_t cacheFormatVersion = 1;
+
+    // Sprites with dimensions above this value are considered as a sign of a corrupted cache file.
+    const int32_t maxSpriteDimension = 4096;
+
+    std::string getCacheFilePath( const std::string & cacheName )
+    {
+        return System::concatPath( Game::GetCacheDir(), cacheName + ".cache" );
+    }
+
+    bool readSprite( ROStreamBuf & stream, fheroes2::Sprite & sprite )
+    {
+        const int32_t width = static_cast<int32_t>( stream.getLE32() );
+        const int32_t height = static_cast<int32_t>( stream.getLE32() );
+        const int32_t x = static_cast<int32_t>( stream.getLE32() );
+        const int32_t y = static_cast<int32_t>( stream.getLE32() );
+        const bool isSingleLayer = ( stream.get() != 0 );
+
+        if ( stream.fail() || width < 0 || height < 0 || width > maxSpriteDimension || height > maxSpriteDimension ) {
+            return false;
+        }
+
+        sprite.setPosition( x, y );
+
+        if ( width == 0 || height == 0 ) {
+            // This is an empty sprite.
+            return true;
+        }
+
+        const size_t size = static_cast<size_t>( width ) * height;
+
+        const auto [imageData, imageSize] = stream.getRawView( size );
+        if ( imageSize != size ) {
+            return false;
+        }
+
+        if ( isSingleLayer ) {
+            sprite._disableTransformLayer();
+        }
+
+        sprite.resize( width, height );
+        memcpy( sprite.image(), imageData, size );
+
+        if ( isSingleLayer ) {
+            return true;
+        }
+
+        const auto [transformData, transformSize] = stream.getRawView( size );
+        if ( transformSize != size ) {
+            return false;
+        }
+
+        memcpy( sprite.transform(), transformData, size );
+
+        return true;
+    }
+
+    void writeSprite( RWStreamBuf & stream, const fheroes2::Sprite & sprite )
+    {
+        if ( sprite.empty() ) {
+            stream.putLE32( 0 );
+            stream.putLE32( 0 );
+            stream.putLE32( static_cast<uint32_t>( sprite.x() ) );
+            stream.putLE32( static_cast<uint32_t>( sprite.y() ) );
+            stream.put( 0 );
+
+            return;
+        }
+
+        stream.putLE32( static_cast<uint32_t>( sprite.width() ) );
+        stream.putLE32( static_cast<uint32_t>( sprite.height() ) );
+        stream.putLE32( static_cast<uint32_t>( sprite.x() ) );
+        stream.putLE32( static_cast<uint32_t>( sprite.y() ) );
+        stream.put( sprite.singleLayer() ? 1 : 0 );
+
+        const size_t size = static_cast<size_t>( sprite.width() ) * sprite.height();
+
+        stream.putRaw( sprite.image(), size );
+
+        if ( !sprite.singleLayer() ) {
+            stream.putRaw( sprite.transform(), size );
+        }
+    }
+}
+
+namespace fheroes2
+{
+    bool loadSpriteCache( const std::string & cacheName, const std::string & key, std::map<int, std::vector<Sprite>> & icnVsSprite )
+    {
+        const std::string path = getCacheFilePath( cacheName );
+        if ( !System::IsFile( path ) ) {
+            return false;
+        }
+
+        StreamFile file;
+        if ( !file.open( path, "rb" ) ) {
+            return false;
+        }
+
+        // The whole cache file is read at once.
+        ROStreamBuf stream = file.getStreamBuf();
+        if ( file.fail() ) {
+            return false;
+        }
+
+        if ( stream.getLE32() != cacheFileMagic || stream.getLE16() != cacheFormatVersion ) {
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "Sprite cache " << cacheName << " has an unsupported format and will be regenerated." )
+            return false;
+        }
+
+        const uint32_t keySize = stream.getLE32();
+        if ( keySize != key.size() || stream.getString( keySize ) != key ) {
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "Sprite cache " << cacheName << " is outdated and will be regenerated." )
+            return false;
+        }
+
+        std::map<int, std::vector<Sprite>> result;
+
+        const uint32_t icnCount = stream.getLE32();
+
+        for ( uint32_t icnIdx = 0; icnIdx < icnCount && !stream.fail(); ++icnIdx ) {
+            const int icnId = static_cast<int>( stream.getLE32() );
+            const uint32_t spriteCount = stream.getLE32();
+
+            // Every sprite takes at least 17 bytes in the cache file.
+            if ( stream.fail() || spriteCount > stream.size() / 17 ) {
+                break;
+            }
+
+            std::vector<Sprite> & sprites = result[icnId];
+            sprites.resize( spriteCount );
+
+            for ( Sprite & sprite : sprites ) {
+                if ( !readSprite( stream, sprite ) ) {
+                    ERROR_LOG( "Sprite cache " << cacheName << " is corrupted." )
+                    return false;
+                }
+            }
+        }
+
+        if ( stream.fail() || result.size() != icnCount ) {
+            ERROR_LOG( "Sprite cache " << cacheName << " is corrupted." )
+            return false;
+        }
+
+        icnVsSprite = std::move( result );
+
+        return true;
+    }
+
+    bool saveSpriteCache( const std::string & cacheName, const std::string & key, const std::map<int, std::vector<Sprite>> & icnVsSprite )
+    {
+        const std::string path = getCacheFilePath( cacheName );
+        const std::string cacheDir = System::GetParentDirectory( path );
+        if ( !System::IsDirectory( cacheDir ) && !System::MakeDirectory( cacheDir ) ) {
+            ERROR_LOG( "Unable to create a directory for the sprite cache: " << cacheDir )
+            return false;
+        }
+
+        RWStreamBuf stream;
+
+        stream.putLE32( cacheFileMagic );
+        stream.putLE16( cacheFormatVersion );
+
+        stream.putLE32( static_cast<uint32_t>( key.size() ) );
+        stream.putRaw( key.data(), key.size() );
+
+        stream.putLE32( static_cast<uint32_t>( icnVsSprite.size() ) );
+
+        for ( const auto & [icnId, sprites] : icnVsSprite ) {
+            stream.putLE32( static_cast<uint32_t>( icnId ) );
+            stream.putLE32( static_cast<uint32_t>( sprites.size() ) );
+
+            for ( const Sprite & sprite : sprites ) {
+                writeSprite( stream, sprite );
+            }
+        }
+
+        StreamFile file;
+        if ( !file.open( path, "wb" ) ) {
+            return false;
+        }
+
+        file.putRaw( stream.data(), stream.size() );
+
+        if ( file.fail() ) {
+            ERROR_LOG( "Unable to write the sprite cache to " << path )
+
+            // Do not leave a partially written cache file.
+            file.close();
+            System::Unlink( path );
+
+            return false;
+        }
+
+        return true;
+    }
+}
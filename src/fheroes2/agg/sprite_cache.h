@@ -0,0 +1,41 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fheroes2
+{
+    class Sprite;
+
+    // Persistent on-disk cache of sprites generated at runtime. Each cache file stores the key of the data it was created for (which
+    // should identify everything the generated sprites depend on, such as the AGG files, the game version and the language), so the
+    // cache is ignored if the key does not match.
+
+    // Reads the sets of sprites (per ICN id) from the cache file with the given name. Returns false if there is no such cache file,
+    // if it is corrupted or if it was created for a different key.
+    bool loadSpriteCache( const std::string & cacheName, const std::string & key, std::map<int, std::vector<Sprite>> & icnVsSprite );
+
+    // Writes the given sets of sprites (per ICN id) to the cache file with the given name, replacing the existing one.
+    bool saveSpriteCache( const std::string & cacheName, const std::string & key, const std::map<int, std::vector<Sprite>> & icnVsSprite );
+}
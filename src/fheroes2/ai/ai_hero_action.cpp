@@ -99,6 +99,10 @@ namespace
         }
         else {
             const PlayerColorsSet humanColor = Players::HumanColors();
+            if ( humanColor == 0 ) {
+                // There are no human players at all (for example, in the headless simulation mode) so there is nobody to show anything to.
+                return colors;
+            }
 
             assert( Color::Count( humanColor ) == 1 );
 
@@ -47,6 +47,13 @@ AI::Planner & AI::Planner::Get()
 void AI::Planner::resetPathfinder()
 {
     _pathfinder.reset();
+
+    _enemyHeroDistances.clear();
+}
+
+void AI::Planner::markPathfinderTileAsChanged( const int32_t tileIndex )
+{
+    _pathfinder.markTileAsChanged( tileIndex );
 }
 
 void AI::Planner::revealFog( const Maps::Tile & tile, const Kingdom & kingdom )
@@ -23,6 +23,7 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <utility>
@@ -174,6 +175,7 @@ namespace AI
         void HeroesActionComplete( Heroes & hero, const int32_t tileIndex, const MP2::MapObjectType objectType );
 
         void resetPathfinder();
+        void markPathfinderTileAsChanged( const int32_t tileIndex );
 
         void revealFog( const Maps::Tile & tile, const Kingdom & kingdom );
 
@@ -214,6 +216,11 @@ namespace AI
 
         int getPriorityTarget( Heroes & hero, double & maxPriority );
 
+        // Returns penalties for all tiles of the map where the given hero may be attacked by a stronger enemy hero. If several enemy
+        // heroes have to be evaluated using the pathfinder, then this evaluation is performed concurrently using _threatPathfinders.
+        // The results of these evaluations are cached in _enemyHeroDistances.
+        std::vector<double> getEnemyThreatPenalties( const Heroes & hero );
+
         double getGeneralObjectValue( const Heroes & hero, const int32_t index, const double valueToIgnore, const uint32_t distanceToObject ) const;
         double getFighterObjectValue( const Heroes & hero, const int32_t index, const double valueToIgnore, const uint32_t distanceToObject ) const;
         double getCourierObjectValue( const Heroes & hero, const int32_t index, const double valueToIgnore, const uint32_t distanceToObject ) const;
@@ -275,5 +282,19 @@ namespace AI
         std::array<BudgetEntry, 7> _budget = { Resource::WOOD, Resource::MERCURY, Resource::ORE, Resource::SULFUR, Resource::CRYSTAL, Resource::GEMS, Resource::GOLD };
 
         AIWorldPathfinder _pathfinder;
+
+        struct EnemyHeroDistances
+        {
+            int32_t index{ -1 };
+            double strength{ 0 };
+            std::vector<uint32_t> distances;
+        };
+
+        // Distances from enemy heroes to all tiles of the map calculated using the "optimistic" pathfinder settings. They are calculated
+        // once per turn and re-calculated only if the position or the army strength of the corresponding enemy hero changes.
+        std::unordered_map<const Heroes *, EnemyHeroDistances> _enemyHeroDistances;
+
+        // Pathfinders used to evaluate enemy threats concurrently, one per thread. They are always reset before use.
+        std::vector<std::unique_ptr<AIWorldPathfinder>> _threatPathfinders;
     };
 }
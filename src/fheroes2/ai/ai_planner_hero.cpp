@@ -26,6 +26,7 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <memory>
 #include <ostream>
 #include <set>
 #include <string>
@@ -74,6 +75,7 @@
 #include "settings.h"
 #include "skill.h"
 #include "spell.h"
+#include "thread.h"
 #include "visit.h"
 #include "world.h"
 #include "world_pathfinding.h"
@@ -1101,6 +1103,56 @@ namespace
 
         return 30;
     }
+
+    struct EnemyThreat
+    {
+        int32_t index{ -1 };
+        uint32_t movePointsThreshold{ 0 };
+        // Distances from the enemy hero to all tiles of the map, if an accurate estimate is used, otherwise nullptr
+        const std::vector<uint32_t> * distances{ nullptr };
+    };
+
+    // Adds penalties for tiles threatened by the given enemy hero
+    void addEnemyThreatPenalties( std::vector<double> & penalties, const EnemyThreat & threat )
+    {
+        assert( threat.distances == nullptr || threat.distances->size() == penalties.size() );
+
+        for ( size_t i = 0; i < penalties.size(); ++i ) {
+            const int32_t tileIdx = static_cast<int32_t>( i );
+            assert( Maps::isValidAbsIndex( tileIdx ) );
+
+            const auto [distToTile, isTileConsideredSafe] = [&threat, tileIdx]() {
+                // The tile on which the enemy hero is located is always considered unsafe
+                if ( tileIdx == threat.index ) {
+                    return std::make_pair( static_cast<uint32_t>( 0 ), false );
+                }
+
+                if ( threat.distances == nullptr ) {
+                    const uint32_t dist = Maps::GetApproximateDistance( tileIdx, threat.index ) * Maps::Ground::fastestMovePenalty;
+
+                    // When using a rough estimate, a tile is considered safe if the enemy hero cannot reach it within one turn, even if the path from the enemy
+                    // hero to this tile is straight and with a minimum movement penalty. The potential ability of the enemy hero to use spells to move to this
+                    // tile (for example, the Dimension Door or Town Portal) is not considered in this assessment.
+                    return std::make_pair( dist, dist > threat.movePointsThreshold );
+                }
+
+                const uint32_t dist = ( *threat.distances )[tileIdx];
+
+                // When using an accurate estimate, a tile is considered safe if the enemy hero does not have access to it (in particular, if it is hidden from
+                // him in the fog) or he cannot reach it within one turn. The potential ability of the enemy hero to use spells to move to this tile (for example,
+                // the Dimension Door or Town Portal) is not considered in this assessment.
+                return std::make_pair( dist, dist == 0 || dist > threat.movePointsThreshold );
+            }();
+
+            if ( isTileConsideredSafe ) {
+                continue;
+            }
+
+            // The penalty is cumulative (i.e. this is the sum of the penalties from all threatening heroes), the penalty from each threatening hero increases
+            // linearly as the distance to that hero decreases
+            penalties[i] += dangerousTaskPenalty * ( 2.0 - static_cast<double>( distToTile ) / static_cast<double>( threat.movePointsThreshold ) );
+        }
+    }
 }
 
 // TODO: In the future we need to come up with dynamic object value estimation based not only on a hero's role but on an outcome from movement at certain position.
@@ -2353,112 +2405,127 @@ int AI::Planner::getCourierMainTarget( const Heroes & hero, const double lowestP
     return targetIndex;
 }
 
-int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
+std::vector<double> AI::Planner::getEnemyThreatPenalties( const Heroes & hero )
 {
-    DEBUG_LOG( DBG_AI, DBG_INFO, "Find Adventure Map target for hero " << hero.GetName() << " at current position " << hero.GetIndex() )
+    std::vector<double> result( world.getSize(), 0.0 );
 
-    const double lowestPossibleValue = -1.0 * Maps::Ground::slowestMovePenalty * world.getSize();
+    const double heroStrength = hero.GetArmy().GetStrength();
 
-    int priorityTarget = -1;
-    maxPriority = lowestPossibleValue;
-#ifdef WITH_DEBUG
-    {
-        std::set<int> objectIndexes;
+    std::vector<EnemyThreat> threats;
+    std::vector<const EnemyArmy *> enemyArmiesToEvaluate;
 
-        for ( const auto & [idx, objType] : _mapActionObjects ) {
-            if ( objType == MP2::OBJ_HERO ) {
-                assert( world.getTile( idx ).getHero() != nullptr );
-            }
+    for ( const auto & [dummy, enemyArmy] : _enemyArmies ) {
+        // Only enemy heroes are taken into account
+        if ( enemyArmy.hero == nullptr ) {
+            continue;
+        }
 
-            if ( const auto [dummy, inserted] = objectIndexes.emplace( idx ); !inserted ) {
-                assert( 0 );
-            }
+        // An enemy hero does not pose a threat if he is approximately equal in strength or weaker than our hero
+        if ( heroStrength * ARMY_ADVANTAGE_SMALL >= enemyArmy.strength ) {
+            continue;
         }
-    }
 
-    MP2::MapObjectType objectType = MP2::OBJ_NONE;
-#endif
+        // In theory, this should never be the case
+        if ( enemyArmy.movePoints == 0 ) {
+            assert( 0 );
+            continue;
+        }
 
-    // Pre-calculate penalties for tiles where there is a threat of enemy attack
-    const std::vector<double> enemyThreatPenalties = [this, &hero = std::as_const( hero )]() {
-        std::vector<double> result( world.getSize(), 0.0 );
+        // Safe tiles should not be located close to a tile accessible to an enemy hero, some margin is needed
+        const uint32_t enemyArmyMovePointsThreshold = enemyArmy.movePoints + Maps::Ground::slowestMovePenalty * 2;
+        // If the enemy hero can't cross paths with our hero anywhere, then it makes sense to use a rough but quick estimate. Otherwise, an accurate but
+        // relatively slow estimate will be used.
+        const bool useRoughEstimate = ( Maps::GetApproximateDistance( hero.GetIndex(), enemyArmy.index ) * Maps::Ground::fastestMovePenalty
+                                        > hero.GetMovePoints() + enemyArmyMovePointsThreshold );
 
-        const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
+        threats.push_back( { enemyArmy.index, enemyArmyMovePointsThreshold, nullptr } );
 
-        // Use the "optimistic" pathfinder settings for enemy heroes - minimal army advantage, minimal reserve of spell points
-        _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
-        _pathfinder.setSpellPointsReserveRatio( 0.0 );
+        if ( useRoughEstimate ) {
+            continue;
+        }
 
-        const double heroStrength = hero.GetArmy().GetStrength();
+        EnemyHeroDistances & enemyHeroDistances = _enemyHeroDistances[enemyArmy.hero];
 
-        for ( const auto & [dummy, enemyArmy] : _enemyArmies ) {
-            // Only enemy heroes are taken into account
-            if ( enemyArmy.hero == nullptr ) {
-                continue;
-            }
+        // Distances from this enemy hero should be calculated if this has not been done during this turn yet, or if they are outdated
+        if ( std::tie( enemyHeroDistances.index, enemyHeroDistances.strength ) != std::tie( enemyArmy.index, enemyArmy.strength ) ) {
+            enemyArmiesToEvaluate.push_back( &enemyArmy );
+        }
 
-            // An enemy hero does not pose a threat if he is approximately equal in strength or weaker than our hero
-            if ( heroStrength * ARMY_ADVANTAGE_SMALL >= enemyArmy.strength ) {
-                continue;
-            }
+        threats.back().distances = &enemyHeroDistances.distances;
+    }
 
-            // In theory, this should never be the case
-            if ( enemyArmy.movePoints == 0 ) {
-                assert( 0 );
-                continue;
-            }
+    if ( !enemyArmiesToEvaluate.empty() ) {
+        // Pathfinding for several enemy heroes is performed concurrently. Each thread uses its own pathfinder, the world is not modified
+        // during these calculations.
+        const uint32_t threadCount = static_cast<uint32_t>( std::min<size_t>( MultiThreading::getWorkerCount(), enemyArmiesToEvaluate.size() ) );
 
-            // Safe tiles should not be located close to a tile accessible to an enemy hero, some margin is needed
-            const uint32_t enemyArmyMovePointsThreshold = enemyArmy.movePoints + Maps::Ground::slowestMovePenalty * 2;
-            // If the enemy hero can't cross paths with our hero anywhere, then it makes sense to use a rough but quick estimate. Otherwise, an accurate but
-            // relatively slow estimate will be used.
-            const bool useRoughEstimate = ( Maps::GetApproximateDistance( hero.GetIndex(), enemyArmy.index ) * Maps::Ground::fastestMovePenalty
-                                            > hero.GetMovePoints() + enemyArmyMovePointsThreshold );
+        while ( _threatPathfinders.size() < threadCount ) {
+            auto & pathfinder = _threatPathfinders.emplace_back( std::make_unique<AIWorldPathfinder>() );
 
-            if ( !useRoughEstimate ) {
-                // Pre-cache the pathfinder database for the enemy hero
-                _pathfinder.reEvaluateIfNeeded( *enemyArmy.hero );
-            }
+            // Use the "optimistic" pathfinder settings for enemy heroes - minimal army advantage, minimal reserve of spell points
+            pathfinder->setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
+            pathfinder->setSpellPointsReserveRatio( 0.0 );
+        }
 
-            for ( size_t i = 0; i < result.size(); ++i ) {
-                const int32_t tileIdx = static_cast<int32_t>( i );
-                assert( Maps::isValidAbsIndex( tileIdx ) );
+        MultiThreading::parallelFor( enemyArmiesToEvaluate.size(), threadCount, [this, &enemyArmiesToEvaluate]( const size_t taskId, const uint32_t threadId ) {
+            const EnemyArmy & enemyArmy = *enemyArmiesToEvaluate[taskId];
+            AIWorldPathfinder & pathfinder = *_threatPathfinders[threadId];
 
-                const auto [distToTile, isTileConsideredSafe] = [this, enemyArmyIdx = enemyArmy.index, enemyArmyMovePointsThreshold, useRoughEstimate, tileIdx]() {
-                    // The tile on which the enemy hero is located is always considered unsafe
-                    if ( tileIdx == enemyArmyIdx ) {
-                        return std::make_pair( static_cast<uint32_t>( 0 ), false );
-                    }
+            // The pathfinder database may be outdated since the last use of this pathfinder, so it should be always re-evaluated
+            pathfinder.reset();
+            pathfinder.reEvaluateIfNeeded( *enemyArmy.hero );
 
-                    if ( useRoughEstimate ) {
-                        const uint32_t dist = Maps::GetApproximateDistance( tileIdx, enemyArmyIdx ) * Maps::Ground::fastestMovePenalty;
+            // Each enemy hero has its own entry, which was created before the concurrent calculations started
+            const auto iter = _enemyHeroDistances.find( enemyArmy.hero );
+            assert( iter != _enemyHeroDistances.end() );
 
-                        // When using a rough estimate, a tile is considered safe if the enemy hero cannot reach it within one turn, even if the path from the enemy
-                        // hero to this tile is straight and with a minimum movement penalty. The potential ability of the enemy hero to use spells to move to this
-                        // tile (for example, the Dimension Door or Town Portal) is not considered in this assessment.
-                        return std::make_pair( dist, dist > enemyArmyMovePointsThreshold );
-                    }
+            EnemyHeroDistances & enemyHeroDistances = iter->second;
 
-                    const uint32_t dist = _pathfinder.getDistance( tileIdx );
+            enemyHeroDistances.index = enemyArmy.index;
+            enemyHeroDistances.strength = enemyArmy.strength;
+            enemyHeroDistances.distances.resize( world.getSize() );
 
-                    // When using an accurate estimate, a tile is considered safe if the enemy hero does not have access to it (in particular, if it is hidden from
-                    // him in the fog) or he cannot reach it within one turn. The potential ability of the enemy hero to use spells to move to this tile (for example,
-                    // the Dimension Door or Town Portal) is not considered in this assessment.
-                    return std::make_pair( dist, dist == 0 || dist > enemyArmyMovePointsThreshold );
-                }();
+            for ( size_t i = 0; i < enemyHeroDistances.distances.size(); ++i ) {
+                enemyHeroDistances.distances[i] = pathfinder.getDistance( static_cast<int>( i ) );
+            }
+        } );
+    }
 
-                if ( isTileConsideredSafe ) {
-                    continue;
-                }
+    for ( const EnemyThreat & threat : threats ) {
+        addEnemyThreatPenalties( result, threat );
+    }
+
+    return result;
+}
 
-                // The penalty is cumulative (i.e. this is the sum of the penalties from all threatening heroes), the penalty from each threatening hero increases
-                // linearly as the distance to that hero decreases
-                result[i] += dangerousTaskPenalty * ( 2.0 - static_cast<double>( distToTile ) / static_cast<double>( enemyArmyMovePointsThreshold ) );
+int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
+{
+    DEBUG_LOG( DBG_AI, DBG_INFO, "Find Adventure Map target for hero " << hero.GetName() << " at current position " << hero.GetIndex() )
+
+    const double lowestPossibleValue = -1.0 * Maps::Ground::slowestMovePenalty * world.getSize();
+
+    int priorityTarget = -1;
+    maxPriority = lowestPossibleValue;
+#ifdef WITH_DEBUG
+    {
+        std::set<int> objectIndexes;
+
+        for ( const auto & [idx, objType] : _mapActionObjects ) {
+            if ( objType == MP2::OBJ_HERO ) {
+                assert( world.getTile( idx ).getHero() != nullptr );
+            }
+
+            if ( const auto [dummy, inserted] = objectIndexes.emplace( idx ); !inserted ) {
+                assert( 0 );
             }
         }
+    }
 
-        return result;
-    }();
+    MP2::MapObjectType objectType = MP2::OBJ_NONE;
+#endif
+
+    // Pre-calculate penalties for tiles where there is a threat of enemy attack
+    const std::vector<double> enemyThreatPenalties = getEnemyThreatPenalties( hero );
 
     // Pre-cache the pathfinder database for our hero
     _pathfinder.reEvaluateIfNeeded( hero );
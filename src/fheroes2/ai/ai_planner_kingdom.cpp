@@ -654,6 +654,7 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
     _mapActionObjects.clear();
     _priorityTargets.clear();
     _enemyArmies.clear();
+    _enemyHeroDistances.clear();
 
     // Clear the tile army strength cache because the strength of the respective armies might have changed since last time
     _tileArmyStrengthValues.clear();
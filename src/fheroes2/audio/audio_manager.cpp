@@ -190,13 +190,14 @@ namespace
     };
 
     std::vector<uint8_t> getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
+    ROStreamBuf getDataStreamFromAggFile( const std::string & key, const bool ignoreExpansion );
 
     void LoadWAV( int m82, std::vector<uint8_t> & v )
     {
         DEBUG_LOG( DBG_GAME, DBG_TRACE, M82::GetString( m82 ) )
-        const std::vector<uint8_t> & body = getDataFromAggFile( M82::GetString( m82 ), false );
+        const ROStreamBuf body = getDataStreamFromAggFile( M82::GetString( m82 ), false );
 
-        if ( !body.empty() ) {
+        if ( body.size() > 0 ) {
             RWStreamBuf wavHeader( 44 );
             wavHeader.putLE32( 0x46464952 ); // RIFF marker ("RIFF")
             wavHeader.putLE32( static_cast<uint32_t>( body.size() ) + 0x24 ); // Total size minus the size of this and previous fields
@@ -214,7 +215,7 @@ namespace
 
             v.reserve( body.size() + 44 );
             v.assign( wavHeader.data(), wavHeader.data() + 44 );
-            v.insert( v.begin() + 44, body.begin(), body.end() );
+            v.insert( v.begin() + 44, body.data(), body.data() + body.size() );
         }
     }
 
@@ -505,6 +506,15 @@ namespace
         return g_midiHeroes2AGG.read( key );
     }
 
+    ROStreamBuf getDataStreamFromAggFile( const std::string & key, const bool ignoreExpansion )
+    {
+        if ( !ignoreExpansion && g_midiHeroes2xAGG.isGood() && g_midiHeroes2xAGG.getFileSize( key ) > 0 ) {
+            return g_midiHeroes2xAGG.getStreamBuf( key );
+        }
+
+        return g_midiHeroes2AGG.getStreamBuf( key );
+    }
+
     AsyncSoundManager g_asyncSoundManager;
 
     int PlaySoundImpl( const int m82 )
@@ -269,14 +269,15 @@ namespace
         const fheroes2::Sprite & luckSprite = fheroes2::AGG::GetICN( ICN::EXPMRL, 0 );
 
         // Get a single rainbow line from the center of the luckSprite.
-        fheroes2::Image croppedRainbow( 1, rainbowThickness );
+        fheroes2::Image croppedRainbow;
         croppedRainbow._disableTransformLayer();
+        croppedRainbow.resize( 1, rainbowThickness );
         fheroes2::Copy( luckSprite, luckSprite.width() / 2, 0, croppedRainbow, 0, 0, 1, rainbowThickness );
         fheroes2::Image rainbowLine;
 
         if ( isVertical ) {
-            rainbowLine = fheroes2::Image( croppedRainbow.height(), croppedRainbow.width() );
             rainbowLine._disableTransformLayer();
+            rainbowLine.resize( croppedRainbow.height(), croppedRainbow.width() );
 
             // For a vertical rainbow orientation the line needs to be transposed.
             fheroes2::Transpose( croppedRainbow, rainbowLine );
@@ -1423,6 +1424,20 @@ Battle::Interface::Interface( Arena & battleArena, const int32_t tileIndex )
         break;
     }
 
+    // Decode the battlefield and monster images in the background while the rest of the battle interface is being prepared.
+    {
+        std::vector<int> icnIds{ _battleGroundIcn, _borderObjectsIcn };
+
+        for ( const Force * force : { &arena.getAttackingForce(), &arena.getDefendingForce() } ) {
+            for ( const Unit * unit : *force ) {
+                icnIds.push_back( unit->GetMonsterSprite() );
+                icnIds.push_back( static_cast<int>( Monster::GetMissileICN( unit->GetID() ) ) );
+            }
+        }
+
+        fheroes2::AGG::preloadResources( icnIds, {} );
+    }
+
     // hexagon
     _hexagonGrid = DrawHexagon( fheroes2::GetColorId( 0x68, 0x8C, 0x04 ) );
     // Shadow under the cursor: the first parameter is the shadow strength (smaller is stronger), the second is the distance between the hexagonal shadows.
@@ -25,7 +25,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <set>
 #include <tuple>
 #include <vector>
 
@@ -74,7 +73,7 @@ namespace Battle
         const bool isMoatBuilt = castle && castle->isBuild( BUILD_MOAT );
 
         _cache.clear();
-        _cache.try_emplace( _pathStart );
+        _cache[_pathStart];
 
         // Flying units can land wherever they can fit
         if ( _isFlying ) {
@@ -90,12 +89,14 @@ namespace Battle
                 const int32_t headCellIdx = pos.GetHead()->GetIndex();
                 const int32_t tailCellIdx = pos.GetTail() ? pos.GetTail()->GetIndex() : -1;
 
-                if ( const auto [iter, inserted] = _cache.try_emplace( { headCellIdx, tailCellIdx } ); inserted ) {
+                const BattleNodeIndex nodeIdx = { headCellIdx, tailCellIdx };
+
+                if ( _cache.find( nodeIdx ) == nullptr ) {
                     // Wide units can occupy overlapping positions, the distance between which is actually zero,
                     // but since the movement takes place, we will consider the distance equal to 1 in this case
                     const uint32_t distance = std::max( Board::GetDistance( unit.GetPosition(), pos ), 1U );
 
-                    iter->second.update( _pathStart, 1, distance );
+                    _cache[nodeIdx].update( _pathStart, 1, distance );
                 }
             }
 
@@ -228,14 +229,12 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        if ( iter == _cache.end() ) {
+        const BattleNode * node = _cache.find( nodeIdx );
+        if ( node == nullptr ) {
             return false;
         }
 
-        const auto & [index, node] = *iter;
-
-        return ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node._cost <= _speed );
+        return ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node->_cost <= _speed );
     }
 
     uint32_t BattlePathfinder::getCost( const Unit & unit, const Position & position )
@@ -246,14 +245,13 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
+        const BattleNode * node = _cache.find( nodeIdx );
+        assert( node != nullptr );
 
-        const auto & [index, node] = *iter;
         // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        assert( ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-        return node._cost;
+        return node->_cost;
     }
 
     uint32_t BattlePathfinder::getDistance( const Unit & unit, const Position & position )
@@ -264,37 +262,41 @@ namespace Battle
 
         const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
+        const BattleNode * node = _cache.find( nodeIdx );
+        assert( node != nullptr );
 
-        const auto & [index, node] = *iter;
         // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        assert( ( nodeIdx == _pathStart || node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-        return node._distance;
+        return node->_distance;
     }
 
     Indexes BattlePathfinder::getAllAvailableMoves( const Unit & unit )
     {
         reEvaluateIfNeeded( unit );
 
-        std::set<int32_t> boardIndexes;
+        Indexes result;
+        result.reserve( Board::sizeInCells );
+
+        // Nodes are ordered by the index of the cell occupied by the unit's head, so the resulting indexes are sorted as well
+        for ( size_t slot = 0; slot < BattleNodeCache::maxNodeCount; ++slot ) {
+            const BattleNode * node = _cache.findBySlot( slot );
+            if ( node == nullptr ) {
+                continue;
+            }
 
-        for ( const auto & [index, node] : _cache ) {
-            if ( index == _pathStart || node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
+            const BattleNodeIndex index = BattleNodeCache::getNodeIndex( slot );
+            if ( index == _pathStart || node->_from == BattleNodeIndex{ -1, -1 } || node->_cost > _speed ) {
                 continue;
             }
 
             assert( index.first != -1 );
 
-            boardIndexes.insert( index.first );
+            if ( result.empty() || result.back() != index.first ) {
+                result.push_back( index.first );
+            }
         }
 
-        Indexes result;
-
-        result.reserve( boardIndexes.size() );
-        result.assign( boardIndexes.begin(), boardIndexes.end() );
-
         return result;
     }
 
@@ -310,21 +312,21 @@ namespace Battle
         BattleNodeIndex lastReachableNodeIdx{ -1, -1 };
         BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        for ( const BattleNode * node = _cache.find( nodeIdx ); node != nullptr; node = _cache.find( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
 
             if ( index == _pathStart ) {
                 break;
             }
 
             // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
+            assert( ( node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-            nodeIdx = node._from;
+            nodeIdx = node->_from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node->_cost > _speed ) {
                 continue;
             }
 
@@ -365,21 +367,21 @@ namespace Battle
 
         BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        for ( const BattleNode * node = _cache.find( nodeIdx ); node != nullptr; node = _cache.find( nodeIdx ) ) {
+            const BattleNodeIndex index = nodeIdx;
 
             if ( index == _pathStart ) {
                 break;
             }
 
             // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
+            assert( ( node->_from != BattleNodeIndex{ -1, -1 } ) );
 
-            nodeIdx = node._from;
+            nodeIdx = node->_from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node->_cost > _speed ) {
                 continue;
             }
 
@@ -21,9 +21,9 @@
 #pragma once
 
 #include <array>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <unordered_map>
 #include <utility>
 
 #include "battle_board.h"
@@ -36,19 +36,6 @@ namespace Battle
 
     using BattleNodeIndex = std::pair<int32_t, int32_t>;
 
-    struct BattleNodeIndexHash final
-    {
-        std::size_t operator()( const BattleNodeIndex & index ) const noexcept
-        {
-            const uint64_t f = index.first;
-            const uint64_t s = index.second;
-
-            std::hash<uint64_t> hasher;
-
-            return hasher( ( f << 32 ) + s );
-        }
-    };
-
     struct BattleNode final
     {
         BattleNodeIndex _from{ -1, -1 };
@@ -70,6 +57,100 @@ namespace Battle
         }
     };
 
+    // Flat storage of the battle graph nodes. Each node is identified by the index of the cell occupied by the unit's head and the index
+    // of the cell occupied by its tail (-1 for units that are not wide). Since the tail of a wide unit is always located either to the left
+    // or to the right of its head, there are at most three nodes per board cell.
+    class BattleNodeCache final
+    {
+    public:
+        static constexpr size_t maxNodeCount = Board::sizeInCells * 3;
+
+        BattleNodeCache() = default;
+        BattleNodeCache( const BattleNodeCache & ) = delete;
+
+        ~BattleNodeCache() = default;
+
+        BattleNodeCache & operator=( const BattleNodeCache & ) = delete;
+
+        // Removes all nodes from the cache. Nodes are not actually cleared, but are marked as outdated instead.
+        void clear()
+        {
+            ++_generation;
+
+            // The generation counter has overflowed, so existing nodes may be mistaken for the actual ones
+            if ( _generation == 0 ) {
+                _nodeGenerations.fill( 0 );
+                _generation = 1;
+            }
+        }
+
+        // Returns the node with the given index, or nullptr if this node has not been added to the cache since the last clear() call
+        const BattleNode * find( const BattleNodeIndex & index ) const
+        {
+            return findBySlot( getSlot( index ) );
+        }
+
+        const BattleNode * findBySlot( const size_t slot ) const
+        {
+            assert( slot < maxNodeCount );
+
+            return _nodeGenerations[slot] == _generation ? &_nodes[slot] : nullptr;
+        }
+
+        // Returns the node with the given index. If this node has not been added to the cache since the last clear() call, then it is
+        // added as a new node.
+        BattleNode & operator[]( const BattleNodeIndex & index )
+        {
+            const size_t slot = getSlot( index );
+
+            if ( _nodeGenerations[slot] != _generation ) {
+                _nodeGenerations[slot] = _generation;
+                _nodes[slot] = {};
+            }
+
+            return _nodes[slot];
+        }
+
+        static BattleNodeIndex getNodeIndex( const size_t slot )
+        {
+            assert( slot < maxNodeCount );
+
+            const int32_t headCellIdx = static_cast<int32_t>( slot / 3 );
+
+            switch ( slot % 3 ) {
+            case 1:
+                return { headCellIdx, headCellIdx - 1 };
+            case 2:
+                return { headCellIdx, headCellIdx + 1 };
+            default:
+                break;
+            }
+
+            return { headCellIdx, -1 };
+        }
+
+    private:
+        static size_t getSlot( const BattleNodeIndex & index )
+        {
+            const auto [headCellIdx, tailCellIdx] = index;
+
+            assert( Board::isValidIndex( headCellIdx ) );
+            assert( tailCellIdx == -1 || tailCellIdx == headCellIdx - 1 || tailCellIdx == headCellIdx + 1 );
+
+            const size_t slot = static_cast<size_t>( headCellIdx ) * 3;
+
+            if ( tailCellIdx == -1 ) {
+                return slot;
+            }
+
+            return slot + ( tailCellIdx < headCellIdx ? 1 : 2 );
+        }
+
+        std::array<BattleNode, maxNodeCount> _nodes;
+        std::array<uint32_t, maxNodeCount> _nodeGenerations{};
+        uint32_t _generation{ 1 };
+    };
+
     class BattlePathfinder final
     {
     public:
@@ -109,7 +190,7 @@ namespace Battle
         // Rebuilds the graph of available positions for the given unit if necessary (if it is not already cached)
         void reEvaluateIfNeeded( const Unit & unit );
 
-        std::unordered_map<BattleNodeIndex, BattleNode, BattleNodeIndexHash> _cache;
+        BattleNodeCache _cache;
 
         // Parameters of the unit for which the current cache is created
         BattleNodeIndex _pathStart{ -1, -1 };
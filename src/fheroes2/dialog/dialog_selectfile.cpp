@@ -231,16 +231,7 @@ namespace
         ListFiles files;
         files.ReadDir( Game::GetSaveDir(), Game::GetSaveFileExtension() );
 
-        MapsFileInfoList mapInfos;
-        mapInfos.reserve( files.size() );
-
-        for ( std::string & saveFile : files ) {
-            Maps::FileInfo mapInfo;
-
-            if ( Game::LoadSAV2FileInfo( std::move( saveFile ), mapInfo ) ) {
-                mapInfos.emplace_back( std::move( mapInfo ) );
-            }
-        }
+        MapsFileInfoList mapInfos = Game::LoadSAV2FileInfos( { std::make_move_iterator( files.begin() ), std::make_move_iterator( files.end() ) } );
 
         sortMapInfos( mapInfos );
 
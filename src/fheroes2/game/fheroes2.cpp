@@ -31,6 +31,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Managing compiler warnings for SDL headers
@@ -65,6 +66,7 @@
 #include "embedded_image.h"
 #include "exception.h"
 #include "game.h"
+#include "game_io.h"
 #include "game_logo.h"
 #include "game_video.h"
 #include "game_video_type.h"
@@ -80,6 +82,7 @@
 #include "settings.h"
 #include "system.h"
 #include "timing.h"
+#include "tools.h"
 #include "ui_tool.h"
 #include "zzlib.h"
 
@@ -269,6 +272,20 @@ namespace
         std::unique_ptr<fheroes2::h2d::H2DInitializer> _h2dInitializer;
     };
 
+    // Makes sure that the save file being written in the background is completed before the application exits.
+    class BackgroundSavingGuard final
+    {
+    public:
+        BackgroundSavingGuard() = default;
+        BackgroundSavingGuard( const BackgroundSavingGuard & ) = delete;
+        BackgroundSavingGuard & operator=( const BackgroundSavingGuard & ) = delete;
+
+        ~BackgroundSavingGuard()
+        {
+            Game::stopBackgroundSaving();
+        }
+    };
+
     // This function checks for a possible situation when a user uses a demo version
     // of the game. There is no 100% certain way to detect this, so assumptions are made.
     bool isProbablyDemoVersion()
@@ -281,6 +298,243 @@ namespace
         const ListFiles maps = Settings::FindFiles( "maps", ".mp2", false );
         return maps.size() == 1;
     }
+
+    // The result of parsing the command line options of a headless mode
+    enum class CommandLineStatus : uint8_t
+    {
+        // The mode is not requested, so the game has to be started as usual.
+        NOT_REQUESTED,
+        // The mode is requested and all its options are valid.
+        VALID,
+        // The mode is requested, but its options are invalid. Neither the mode nor the game has to be started.
+        INVALID
+    };
+
+    void printCommandLineUsage()
+    {
+        COUT( "Usage:" )
+        COUT( "  fheroes2 --headless <map file> [--days <number of days>]" )
+        COUT( "  fheroes2 --battles <attacking army> <defending army> [--count <number of battles>] [--seed <seed of the first battle>]" )
+        COUT( "  fheroes2 --pathfinding-benchmark <map file> [--runs <number of runs>]" )
+        COUT( "  fheroes2 --battle-pathfinding-benchmark <attacking army> <defending army> [--runs <number of runs>]" )
+    }
+
+    // Only one headless mode can be requested at a time, because each of them prepares the world in its own way.
+    bool isSingleModeRequested( const int argc, char ** argv )
+    {
+        int modeCount = 0;
+
+        for ( int i = 1; i < argc; ++i ) {
+            const std::string_view argument{ argv[i] };
+
+            if ( argument == "--headless" || argument == "--battles" || argument == "--pathfinding-benchmark" || argument == "--battle-pathfinding-benchmark" ) {
+                ++modeCount;
+            }
+        }
+
+        return modeCount <= 1;
+    }
+
+    struct HeadlessOptions
+    {
+        std::string mapFilePath;
+        uint32_t maxDays{ 0 };
+    };
+
+    // The headless mode is requested by the following command line: fheroes2 --headless <map file> [--days <number of days>]
+    CommandLineStatus getHeadlessOptions( const int argc, char ** argv, HeadlessOptions & options )
+    {
+        bool isRequested = false;
+
+        for ( int i = 1; i < argc; ++i ) {
+            const std::string_view argument{ argv[i] };
+
+            if ( argument != "--headless" && argument != "--days" ) {
+                continue;
+            }
+
+            if ( i + 1 >= argc ) {
+                ERROR_LOG( "The " << argument << " option requires a value." )
+                return CommandLineStatus::INVALID;
+            }
+
+            isRequested = true;
+
+            if ( argument == "--headless" ) {
+                options.mapFilePath = argv[++i];
+                continue;
+            }
+
+            const std::string_view value{ argv[++i] };
+
+            if ( !fheroes2::parseNumber( value, options.maxDays ) ) {
+                ERROR_LOG( "Invalid number of days: '" << value << "'." )
+                return CommandLineStatus::INVALID;
+            }
+        }
+
+        if ( !isRequested ) {
+            return CommandLineStatus::NOT_REQUESTED;
+        }
+
+        if ( options.mapFilePath.empty() ) {
+            ERROR_LOG( "The headless mode requires a map file to be specified with the --headless option." )
+            return CommandLineStatus::INVALID;
+        }
+
+        return CommandLineStatus::VALID;
+    }
+
+    struct BattleSimulationOptions
+    {
+        std::string attackingArmy;
+        std::string defendingArmy;
+        uint32_t battleCount{ 100 };
+        uint32_t firstSeed{ 0 };
+    };
+
+    // The battle simulation mode is requested by the following command line:
+    // fheroes2 --battles <attacking army> <defending army> [--count <number of battles>] [--seed <seed of the first battle>]
+    CommandLineStatus getBattleSimulationOptions( const int argc, char ** argv, BattleSimulationOptions & options )
+    {
+        bool isRequested = false;
+
+        for ( int i = 1; i < argc; ++i ) {
+            const std::string_view argument{ argv[i] };
+
+            if ( argument == "--battles" ) {
+                if ( i + 2 >= argc ) {
+                    ERROR_LOG( "The --battles option requires both attacking and defending armies to be specified." )
+                    return CommandLineStatus::INVALID;
+                }
+
+                isRequested = true;
+
+                options.attackingArmy = argv[++i];
+                options.defendingArmy = argv[++i];
+            }
+            else if ( argument == "--count" || argument == "--seed" ) {
+                if ( i + 1 >= argc ) {
+                    ERROR_LOG( "The " << argument << " option requires a value." )
+                    return CommandLineStatus::INVALID;
+                }
+
+                isRequested = true;
+
+                const std::string_view value{ argv[++i] };
+
+                uint32_t & number = ( argument == "--count" ) ? options.battleCount : options.firstSeed;
+                if ( !fheroes2::parseNumber( value, number ) ) {
+                    ERROR_LOG( "Invalid value of the " << argument << " option: '" << value << "'." )
+                    return CommandLineStatus::INVALID;
+                }
+            }
+        }
+
+        if ( !isRequested ) {
+            return CommandLineStatus::NOT_REQUESTED;
+        }
+
+        if ( options.attackingArmy.empty() || options.defendingArmy.empty() ) {
+            ERROR_LOG( "The battle simulation mode requires armies to be specified with the --battles option." )
+            return CommandLineStatus::INVALID;
+        }
+
+        return CommandLineStatus::VALID;
+    }
+
+    struct PathfindingBenchmarkOptions
+    {
+        std::string mapFilePath;
+        std::string attackingArmy;
+        std::string defendingArmy;
+        uint32_t runCount{ 10 };
+    };
+
+    // The pathfinding benchmark mode is requested by one of the following command lines:
+    // fheroes2 --pathfinding-benchmark <map file> [--runs <number of runs>]
+    // fheroes2 --battle-pathfinding-benchmark <attacking army> <defending army> [--runs <number of runs>]
+    CommandLineStatus getPathfindingBenchmarkOptions( const int argc, char ** argv, PathfindingBenchmarkOptions & options )
+    {
+        bool isRequested = false;
+
+        for ( int i = 1; i < argc; ++i ) {
+            const std::string_view argument{ argv[i] };
+
+            if ( argument == "--battle-pathfinding-benchmark" ) {
+                if ( i + 2 >= argc ) {
+                    ERROR_LOG( "The --battle-pathfinding-benchmark option requires both attacking and defending armies to be specified." )
+                    return CommandLineStatus::INVALID;
+                }
+
+                isRequested = true;
+
+                options.attackingArmy = argv[++i];
+                options.defendingArmy = argv[++i];
+
+                continue;
+            }
+
+            if ( argument != "--pathfinding-benchmark" && argument != "--runs" ) {
+                continue;
+            }
+
+            if ( i + 1 >= argc ) {
+                ERROR_LOG( "The " << argument << " option requires a value." )
+                return CommandLineStatus::INVALID;
+            }
+
+            isRequested = true;
+
+            if ( argument == "--pathfinding-benchmark" ) {
+                options.mapFilePath = argv[++i];
+                continue;
+            }
+
+            const std::string_view value{ argv[++i] };
+
+            if ( !fheroes2::parseNumber( value, options.runCount ) ) {
+                ERROR_LOG( "Invalid number of runs: '" << value << "'." )
+                return CommandLineStatus::INVALID;
+            }
+        }
+
+        if ( !isRequested ) {
+            return CommandLineStatus::NOT_REQUESTED;
+        }
+
+        // The --runs option alone is not enough to choose the benchmark. Both benchmarks at once are rejected by isSingleModeRequested().
+        if ( options.mapFilePath.empty() && options.attackingArmy.empty() ) {
+            ERROR_LOG( "The pathfinding benchmark mode requires either a map file to be specified with the --pathfinding-benchmark option, "
+                       "or armies to be specified with the --battle-pathfinding-benchmark option." )
+            return CommandLineStatus::INVALID;
+        }
+
+        return CommandLineStatus::VALID;
+    }
+
+    // Runs the given simulation without video and audio devices. Game resources are still required.
+    int runHeadless( const std::function<bool()> & simulation )
+    {
+        fheroes2::enableHeadlessMode();
+
+        // Neither audio nor video subsystems are initialized so all audio and rendering calls become no-op.
+        const fheroes2::CoreInitializer coreInitializer( {} );
+
+        fheroes2::Display::instance().setResolution( { fheroes2::Display::DEFAULT_WIDTH, fheroes2::Display::DEFAULT_HEIGHT } );
+
+        const AGG::AGGInitializer aggInitializer;
+        const fheroes2::h2d::H2DInitializer h2dInitializer;
+
+        fheroes2::setGamePalette( AGG::getDataFromAggFile( "KB.PAL", false ) );
+
+        Settings & conf = Settings::Get();
+        conf.setGameLanguage( conf.getGameLanguage() );
+
+        Game::Init();
+
+        return simulation() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
 }
 
 int main( int argc, char ** argv )
@@ -290,8 +544,6 @@ int main( int argc, char ** argv )
     assert( argc == __argc );
 
     argv = __argv;
-#else
-    (void)argc;
 #endif
 
     try {
@@ -307,6 +559,53 @@ int main( int argc, char ** argv )
         InitDataDir();
         ReadConfigs();
 
+        if ( !isSingleModeRequested( argc, argv ) ) {
+            ERROR_LOG( "Only one of the --headless, --battles, --pathfinding-benchmark and --battle-pathfinding-benchmark options can be specified." )
+            printCommandLineUsage();
+            return EXIT_FAILURE;
+        }
+
+        HeadlessOptions headlessOptions;
+        const CommandLineStatus headlessStatus = getHeadlessOptions( argc, argv, headlessOptions );
+        if ( headlessStatus == CommandLineStatus::INVALID ) {
+            printCommandLineUsage();
+            return EXIT_FAILURE;
+        }
+
+        if ( headlessStatus == CommandLineStatus::VALID ) {
+            return runHeadless( [&headlessOptions]() { return Game::runAISimulation( headlessOptions.mapFilePath, headlessOptions.maxDays ); } );
+        }
+
+        BattleSimulationOptions battleOptions;
+        const CommandLineStatus battleStatus = getBattleSimulationOptions( argc, argv, battleOptions );
+        if ( battleStatus == CommandLineStatus::INVALID ) {
+            printCommandLineUsage();
+            return EXIT_FAILURE;
+        }
+
+        if ( battleStatus == CommandLineStatus::VALID ) {
+            return runHeadless( [&battleOptions]() {
+                return Game::runBattleSimulation( battleOptions.attackingArmy, battleOptions.defendingArmy, battleOptions.firstSeed, battleOptions.battleCount );
+            } );
+        }
+
+        PathfindingBenchmarkOptions benchmarkOptions;
+        const CommandLineStatus benchmarkStatus = getPathfindingBenchmarkOptions( argc, argv, benchmarkOptions );
+        if ( benchmarkStatus == CommandLineStatus::INVALID ) {
+            printCommandLineUsage();
+            return EXIT_FAILURE;
+        }
+
+        if ( benchmarkStatus == CommandLineStatus::VALID ) {
+            return runHeadless( [&benchmarkOptions]() {
+                if ( !benchmarkOptions.mapFilePath.empty() ) {
+                    return Game::runWorldPathfindingBenchmark( benchmarkOptions.mapFilePath, benchmarkOptions.runCount );
+                }
+
+                return Game::runBattlePathfindingBenchmark( benchmarkOptions.attackingArmy, benchmarkOptions.defendingArmy, benchmarkOptions.runCount );
+            } );
+        }
+
         std::set<fheroes2::SystemInitializationComponent> coreComponents{ fheroes2::SystemInitializationComponent::Audio,
                                                                           fheroes2::SystemInitializationComponent::Video };
 
@@ -365,6 +664,8 @@ int main( int argc, char ** argv )
         // Initialize game data.
         Game::Init();
 
+        const BackgroundSavingGuard backgroundSavingGuard;
+
         if ( conf.isShowIntro() ) {
             fheroes2::showTeamInfo();
             for ( const auto & logo : { "NWCLOGO.SMK", "CYLOGO.SMK", "H2XINTRO.SMK" } ) {
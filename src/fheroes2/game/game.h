@@ -75,6 +75,28 @@ namespace Game
     fheroes2::GameMode CompleteCampaignScenario( const bool isLoadingSaveFile );
     fheroes2::GameMode DisplayHighScores( const bool isCampaign );
 
+    // Plays the given map with all players controlled by AI without any user interaction until only one alliance is left or
+    // the given number of days has passed (0 means no limit). The result is written to the standard output as a JSON object.
+    // Returns false if the map cannot be loaded.
+    bool runAISimulation( const std::string & mapFilePath, const uint32_t maxDays );
+
+    // Plays the given number of battles between two armies controlled by AI without any user interaction. Each army is described
+    // as '[<hero id>/]<monster id>:<count>[,<monster id>:<count>...]'. The battle number N uses 'firstSeed + N' as the random seed.
+    // The summary is written to the standard output as a JSON object. Returns false if any of the armies cannot be created.
+    bool runBattleSimulation( const std::string & attackingArmySpec, const std::string & defendingArmySpec, const uint32_t firstSeed, const uint32_t battleCount );
+
+    // Measures the time it takes to process the whole map by the world pathfinders (both the player's and the AI's ones) for each
+    // hero on the given map. The pathfinder cache is reset before each evaluation, so each evaluation starts from scratch. The
+    // evaluation of all heroes is repeated the given number of times. The results are written to the standard output as a JSON
+    // object. Returns false if the map cannot be loaded or there are no heroes on it.
+    bool runWorldPathfindingBenchmark( const std::string & mapFilePath, const uint32_t runCount );
+
+    // Measures the time it takes to build the battle pathfinder graph for each unit of the battle between two armies described the same
+    // way as for runBattleSimulation(). The graph is built for each unit in turn, so it is rebuilt from scratch every time. All units are
+    // evaluated the given number of times. The results are written to the standard output as a JSON object. Returns false if any of the
+    // armies cannot be created.
+    bool runBattlePathfindingBenchmark( const std::string & attackingArmySpec, const std::string & defendingArmySpec, const uint32_t runCount );
+
     bool isSuccessionWarsCampaignPresent();
     bool isPriceOfLoyaltyCampaignPresent();
 
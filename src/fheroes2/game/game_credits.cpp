@@ -148,6 +148,30 @@ namespace
         };
     };
 
+    // Returns a single-layer copy of the first image of the given ICN. The transform layer is not needed for the credits pages, so the copy is
+    // made single-layer from the beginning to avoid allocating it.
+    fheroes2::Sprite getPageBackground( const int icnId )
+    {
+        const fheroes2::Sprite & original = fheroes2::AGG::GetICN( icnId, 0 );
+
+        fheroes2::Sprite output;
+        output._disableTransformLayer();
+        fheroes2::Copy( original, output );
+        output.setPosition( original.x(), original.y() );
+
+        return output;
+    }
+
+    fheroes2::Sprite getDarkenedPageBackground( const int icnId )
+    {
+        fheroes2::Sprite output = getPageBackground( icnId );
+
+        // The palette is applied using the original image to darken only its non-transparent pixels.
+        fheroes2::ApplyPalette( fheroes2::AGG::GetICN( icnId, 0 ), output, PAL::GetPalette( PAL::PaletteType::DARKENING ) );
+
+        return output;
+    }
+
     fheroes2::Sprite generateHeader()
     {
         const fheroes2::Sprite & background = fheroes2::AGG::GetICN( ICN::CBKGLAVA, 0 );
@@ -179,8 +203,7 @@ namespace
 
     fheroes2::Sprite generateResurrectionCreditsFirstPage()
     {
-        fheroes2::Sprite output = fheroes2::AGG::GetICN( ICN::CBKGLAVA, 0 );
-        output._disableTransformLayer();
+        fheroes2::Sprite output = getPageBackground( ICN::CBKGLAVA );
 
         const int32_t columnStep = 210;
         const int32_t textInitialOffsetY = 42;
@@ -263,8 +286,7 @@ namespace
 
     fheroes2::Sprite generateResurrectionCreditsSecondPage()
     {
-        fheroes2::Sprite output = fheroes2::AGG::GetICN( ICN::CBKGLAVA, 0 );
-        output._disableTransformLayer();
+        fheroes2::Sprite output = getPageBackground( ICN::CBKGLAVA );
 
         const int32_t columnStep = 210;
         const int32_t textInitialOffsetX = output.width() / 2;
@@ -353,8 +375,7 @@ namespace
 
     fheroes2::Sprite generateResurrectionCreditsThirdPage()
     {
-        fheroes2::Sprite output = fheroes2::AGG::GetICN( ICN::CBKGSWMP, 0 );
-        output._disableTransformLayer();
+        fheroes2::Sprite output = getPageBackground( ICN::CBKGSWMP );
 
         const int32_t textInitialOffsetX = output.width() / 2;
         const int32_t textInitialOffsetY = 80;
@@ -410,9 +431,7 @@ namespace
 
     fheroes2::Sprite generateSuccessionWarsCreditsFirstPage()
     {
-        fheroes2::Sprite output = fheroes2::AGG::GetICN( ICN::CBKGWATR, 0 );
-        fheroes2::ApplyPalette( output, PAL::GetPalette( PAL::PaletteType::DARKENING ) );
-        output._disableTransformLayer();
+        fheroes2::Sprite output = getDarkenedPageBackground( ICN::CBKGWATR );
 
         const fheroes2::FontType nameFontType = fheroes2::FontType::normalWhite();
 
@@ -473,9 +492,7 @@ namespace
 
     fheroes2::Sprite generateSuccessionWarsCreditsSecondPage()
     {
-        fheroes2::Sprite output = fheroes2::AGG::GetICN( ICN::CBKGWATR, 0 );
-        fheroes2::ApplyPalette( output, PAL::GetPalette( PAL::PaletteType::DARKENING ) );
-        output._disableTransformLayer();
+        fheroes2::Sprite output = getDarkenedPageBackground( ICN::CBKGWATR );
 
         const fheroes2::FontType nameFontType = fheroes2::FontType::normalWhite();
 
@@ -533,9 +550,7 @@ namespace
 
     fheroes2::Sprite generatePriceOfLoyaltyCreditsFirstPage()
     {
-        fheroes2::Sprite output = fheroes2::AGG::GetICN( ICN::CBKGGRAV, 0 );
-        fheroes2::ApplyPalette( output, PAL::GetPalette( PAL::PaletteType::DARKENING ) );
-        output._disableTransformLayer();
+        fheroes2::Sprite output = getDarkenedPageBackground( ICN::CBKGGRAV );
 
         const fheroes2::FontType titleFontType = fheroes2::FontType::normalYellow();
         const fheroes2::FontType nameFontType = fheroes2::FontType::normalWhite();
@@ -584,9 +599,7 @@ namespace
 
     fheroes2::Sprite generatePriceOfLoyaltyCreditsSecondPage()
     {
-        fheroes2::Sprite output = fheroes2::AGG::GetICN( ICN::CBKGGRAV, 0 );
-        fheroes2::ApplyPalette( output, PAL::GetPalette( PAL::PaletteType::DARKENING ) );
-        output._disableTransformLayer();
+        fheroes2::Sprite output = getDarkenedPageBackground( ICN::CBKGGRAV );
 
         const fheroes2::FontType titleFontType = fheroes2::FontType::normalYellow();
         const fheroes2::FontType nameFontType = fheroes2::FontType::normalWhite();
@@ -644,9 +657,7 @@ namespace
 
     fheroes2::Sprite generatePriceOfLoyaltyCreditsThirdPage()
     {
-        fheroes2::Sprite output = fheroes2::AGG::GetICN( ICN::CBKGGRAV, 0 );
-        fheroes2::ApplyPalette( output, PAL::GetPalette( PAL::PaletteType::DARKENING ) );
-        output._disableTransformLayer();
+        fheroes2::Sprite output = getDarkenedPageBackground( ICN::CBKGGRAV );
 
         const fheroes2::FontType titleFontType = fheroes2::FontType::normalYellow();
         const fheroes2::FontType nameFontType = fheroes2::FontType::normalWhite();
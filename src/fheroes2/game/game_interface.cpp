@@ -126,6 +126,12 @@ void Interface::AdventureMap::redraw( const uint32_t force )
         return;
     }
 
+    if ( fheroes2::isHeadlessMode() ) {
+        // Nobody is going to see the result of rendering.
+        _redraw = 0;
+        return;
+    }
+
     const Settings & conf = Settings::Get();
 
     const uint32_t combinedRedraw = _redraw | force;
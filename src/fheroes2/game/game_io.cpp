@@ -25,10 +25,16 @@
 
 #include <algorithm>
 #include <cctype>
+#include <condition_variable>
 #include <cstdint>
 #include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
 #include <utility>
+#include <vector>
 
 #include "campaign_savedata.h"
 #include "campaign_scenariodata.h"
@@ -42,6 +48,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "translations.h"
 #include "ui_dialog.h"
 #include "ui_font.h"
@@ -57,7 +64,8 @@ namespace
 
     const uint16_t saveFileMagicNumber{ 0xFF03 };
 
-    uint16_t versionOfCurrentSaveFile = CURRENT_FORMAT_VERSION;
+    // Save file headers are read by multiple threads at once so every thread has its own version of the save file being read.
+    thread_local uint16_t versionOfCurrentSaveFile = CURRENT_FORMAT_VERSION;
 
     std::string lastSaveName;
 
@@ -101,58 +109,344 @@ namespace
     {
         return stream >> hdr.requirements >> hdr.info >> hdr.gameType;
     }
-}
 
-bool Game::AutoSave()
-{
-    return Game::Save( System::concatPath( GetSaveDir(), autoSaveName + GetSaveFileExtension() ), true );
-}
+    bool readSaveFileHeader( const std::string & filePath, HeaderSAV & header )
+    {
+        DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
-bool Game::QuickSave()
-{
-    return Game::Save( System::concatPath( GetSaveDir(), quickSaveName + GetSaveFileExtension() ), false );
-}
+        StreamFile fs;
+        fs.setBigendian( true );
 
-bool Game::Save( const std::string & filePath, const bool autoSave /* = false */ )
-{
-    DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
+        if ( !fs.open( filePath, "rb" ) ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
+            return false;
+        }
 
-    StreamFile fileStream;
-    fileStream.setBigendian( true );
+        uint16_t magicNumber = 0;
+        fs >> magicNumber;
 
-    if ( !fileStream.open( filePath, "wb" ) ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
-        return false;
+        if ( magicNumber != saveFileMagicNumber ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Invalid file identifier in the file " << filePath )
+            return false;
+        }
+
+        std::string saveFileVersionStr;
+        uint16_t saveFileVersion = 0;
+
+        fs >> saveFileVersionStr >> saveFileVersion;
+
+        DEBUG_LOG( DBG_GAME, DBG_TRACE, "Version of the file " << filePath << ": " << saveFileVersion )
+
+        if ( saveFileVersion > CURRENT_FORMAT_VERSION || saveFileVersion < LAST_SUPPORTED_FORMAT_VERSION ) {
+            return false;
+        }
+
+        Game::SetVersionOfCurrentSaveFile( saveFileVersion );
+
+        fs >> header;
+
+        return !fs.fail();
     }
 
-    // Always use the latest version of the file save format
-    SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
-    const uint16_t saveFileVersion = CURRENT_FORMAT_VERSION;
+    // Cache of save file headers. A save file header is read again only if the size or the modification time of the file is changed.
+    class SaveFileHeaderCache final
+    {
+    public:
+        // Returns the information about all given save files which can be loaded in the current game mode.
+        // Save files which are not present in the cache are read in parallel.
+        MapsFileInfoList getFileInfos( const std::vector<std::string> & filePaths )
+        {
+            std::map<std::string, Entry> entries;
+            std::vector<std::pair<const std::string *, Entry *>> entriesToRead;
+
+            for ( const std::string & filePath : filePaths ) {
+                uint64_t size = 0;
+                int64_t modificationTime = 0;
+                if ( !System::GetFileSizeAndModificationTime( filePath, size, modificationTime ) ) {
+                    continue;
+                }
+
+                const auto [iter, isInserted] = entries.try_emplace( filePath );
+                if ( !isInserted ) {
+                    // This is a duplicate path.
+                    continue;
+                }
+
+                Entry & entry = iter->second;
+
+                if ( const auto cachedIter = _entries.find( filePath ); cachedIter != _entries.end() && cachedIter->second.size == size
+                                                                         && cachedIter->second.modificationTime == modificationTime ) {
+                    entry = std::move( cachedIter->second );
+                    continue;
+                }
+
+                entry.size = size;
+                entry.modificationTime = modificationTime;
+
+                entriesToRead.emplace_back( &iter->first, &entry );
+            }
+
+            if ( !entriesToRead.empty() ) {
+                DEBUG_LOG( DBG_GAME, DBG_INFO, "Reading headers of " << entriesToRead.size() << " new or changed save files out of " << filePaths.size() )
+
+                MultiThreading::parallelFor( entriesToRead.size(), MultiThreading::getWorkerCount(),
+                                             [&entriesToRead]( const size_t taskId, const uint32_t /* threadId */ ) {
+                                                 const auto & [filePath, entry] = entriesToRead[taskId];
+
+                                                 entry->isValid = readSaveFileHeader( *filePath, entry->header );
+                                             } );
+            }
+
+            // Entries of the files which do not exist anymore are dropped.
+            _entries = std::move( entries );
+
+            const int gameType = Settings::Get().GameType();
 
-    // Header
-    const Settings & conf = Settings::Get();
+            MapsFileInfoList result;
+            result.reserve( _entries.size() );
 
-    fileStream << saveFileMagicNumber << std::to_string( saveFileVersion ) << saveFileVersion
+            for ( const auto & [filePath, entry] : _entries ) {
+                if ( !entry.isValid || ( gameType & entry.header.gameType ) == 0 ) {
+                    continue;
+                }
+
+                Maps::FileInfo & fileInfo = result.emplace_back( entry.header.info );
+                fileInfo.filename = filePath;
+            }
+
+            return result;
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t size{ 0 };
+            int64_t modificationTime{ 0 };
+            bool isValid{ false };
+            HeaderSAV header;
+        };
+
+        std::map<std::string, Entry> _entries;
+    };
+
+    SaveFileHeaderCache saveFileHeaderCache;
+
+    bool writeSaveFileHeader( OStreamBase & stream )
+    {
+        const uint16_t saveFileVersion = CURRENT_FORMAT_VERSION;
+
+        const Settings & conf = Settings::Get();
+
+        stream << saveFileMagicNumber << std::to_string( saveFileVersion ) << saveFileVersion
                << HeaderSAV( conf.getCurrentMapInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
-    if ( fileStream.fail() ) {
-        return false;
+
+        return !stream.fail();
     }
 
-    RWStreamBuf dataStream;
-    dataStream.setBigendian( true );
+    bool writeGameData( OStreamBase & stream )
+    {
+        const Settings & conf = Settings::Get();
 
-    dataStream << World::Get() << conf << GameOver::Result::Get();
-    if ( dataStream.fail() ) {
-        return false;
+        stream << World::Get() << conf << GameOver::Result::Get();
+        if ( stream.fail() ) {
+            return false;
+        }
+
+        if ( conf.isCampaignGameType() ) {
+            stream << Campaign::CampaignSaveData::Get();
+        }
+
+        // End-of-data marker
+        stream << saveFileMagicNumber;
+
+        return !stream.fail();
     }
 
-    if ( conf.isCampaignGameType() ) {
-        dataStream << Campaign::CampaignSaveData::Get();
+    // Writes save files in the background. The game data is serialized by the main thread, while the compression of this data and
+    // the writing of the save file are performed by the worker thread, so the game does not have to wait for them.
+    class BackgroundSaver final : public MultiThreading::AsyncManager
+    {
+    public:
+        void push( std::string filePath, std::unique_ptr<RWStreamBuf> header, std::unique_ptr<RWStreamBuf> data )
+        {
+            createWorker();
+
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            // Only one save file is written at a time, so there is no more than one snapshot of the game data in memory.
+            _taskCompletion.wait( lock, [this] { return !_pendingTask && !_currentTask; } );
+
+            _pendingTask = Task{ std::move( filePath ), std::move( header ), std::move( data ) };
+
+            notifyWorker();
+        }
+
+        // Waits for the save file being written in the background (if any) to be completed.
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            _taskCompletion.wait( lock, [this] { return !_pendingTask && !_currentTask; } );
+        }
+
+    private:
+        struct Task
+        {
+            std::string filePath;
+            std::unique_ptr<RWStreamBuf> header;
+            std::unique_ptr<RWStreamBuf> data;
+        };
+
+        std::optional<Task> _pendingTask;
+        std::optional<Task> _currentTask;
+
+        std::condition_variable _taskCompletion;
+
+        bool prepareTask() override
+        {
+            _currentTask = std::move( _pendingTask );
+            _pendingTask.reset();
+
+            return false;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            // The _currentTask is modified only by the worker thread, so it is safe to read it without locking.
+            if ( !_currentTask ) {
+                // Nothing to do.
+                return;
+            }
+
+            if ( !writeSaveFile( _currentTask->filePath, *_currentTask->header, *_currentTask->data ) ) {
+                ERROR_LOG( "Unable to write the save file " << _currentTask->filePath )
+            }
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _currentTask.reset();
+            }
+
+            _taskCompletion.notify_all();
+        }
+
+        static bool writeSaveFile( const std::string & filePath, const RWStreamBuf & header, const RWStreamBuf & data )
+        {
+            // The data is written to a temporary file first which then replaces the existing save file, so the existing save file
+            // is not corrupted if the application crashes or the device is powered off in the middle of writing.
+            const std::string tempFilePath = filePath + ".tmp";
+
+            {
+                StreamFile fileStream;
+                fileStream.setBigendian( true );
+
+                if ( !fileStream.open( tempFilePath, "wb" ) ) {
+                    return false;
+                }
+
+                fileStream.putRaw( header.data(), header.size() );
+
+                // Autosaves are written often, so the speed is preferred over the size of the file.
+                Compression::ZipFileOStream dataStream( fileStream, Compression::Level::FAST );
+                dataStream.putRaw( data.data(), data.size() );
+
+                if ( fileStream.fail() || !dataStream.finish() || !fileStream.sync() ) {
+                    // Do not leave a partially written file.
+                    fileStream.close();
+                    System::Unlink( tempFilePath );
+
+                    return false;
+                }
+            }
+
+            if ( !System::Rename( tempFilePath, filePath ) ) {
+                System::Unlink( tempFilePath );
+
+                return false;
+            }
+
+            return true;
+        }
+    };
+
+    BackgroundSaver backgroundSaver;
+
+    bool saveGame( const std::string & filePath, const Compression::Level level )
+    {
+        DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
+
+        // The same file may be being written in the background at the moment.
+        Game::waitForBackgroundSaving();
+
+        StreamFile fileStream;
+        fileStream.setBigendian( true );
+
+        if ( !fileStream.open( filePath, "wb" ) ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
+            return false;
+        }
+
+        // Always use the latest version of the file save format
+        Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+
+        if ( !writeSaveFileHeader( fileStream ) ) {
+            return false;
+        }
+
+        // The game data is zipped on the fly while being serialized, so it is never kept in memory as a whole.
+        Compression::ZipFileOStream dataStream( fileStream, level );
+        dataStream.setBigendian( true );
+
+        return writeGameData( dataStream ) && dataStream.finish();
     }
+}
+
+bool Game::AutoSave()
+{
+    const std::string filePath = System::concatPath( GetSaveDir(), autoSaveName + GetSaveFileExtension() );
+
+    DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
-    // End-of-data marker
-    dataStream << saveFileMagicNumber;
-    if ( dataStream.fail() || !Compression::zipStreamBuf( dataStream, fileStream ) ) {
+    // Always use the latest version of the file save format
+    SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+
+    // Only the serialization of the game data is done here, everything else is done in the background.
+    auto header = std::make_unique<RWStreamBuf>();
+    header->setBigendian( true );
+
+    auto data = std::make_unique<RWStreamBuf>();
+    data->setBigendian( true );
+
+    if ( !writeSaveFileHeader( *header ) || !writeGameData( *data ) ) {
+        return false;
+    }
+
+    backgroundSaver.push( filePath, std::move( header ), std::move( data ) );
+
+    return true;
+}
+
+void Game::waitForBackgroundSaving()
+{
+    backgroundSaver.wait();
+}
+
+void Game::stopBackgroundSaving()
+{
+    backgroundSaver.wait();
+    backgroundSaver.stopWorker();
+}
+
+bool Game::QuickSave()
+{
+    return Game::Save( System::concatPath( GetSaveDir(), quickSaveName + GetSaveFileExtension() ), false );
+}
+
+bool Game::Save( const std::string & filePath, const bool autoSave /* = false */ )
+{
+    if ( !saveGame( filePath, autoSave ? Compression::Level::FAST : Compression::Level::DEFAULT ) ) {
         return false;
     }
 
@@ -167,6 +461,9 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
+    // This file may be being written in the background at the moment.
+    waitForBackgroundSaving();
+
     const auto showGenericErrorMessage = []() { fheroes2::showStandardTextMessage( _( "Error" ), _( "The save file is corrupted." ), Dialog::OK ); };
 
     StreamFile fileStream;
@@ -306,41 +603,8 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
 
 bool Game::LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo )
 {
-    DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
-
-    StreamFile fs;
-    fs.setBigendian( true );
-
-    if ( !fs.open( filePath, "rb" ) ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
-        return false;
-    }
-
-    uint16_t magicNumber = 0;
-    fs >> magicNumber;
-
-    if ( magicNumber != saveFileMagicNumber ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Invalid file identifier in the file " << filePath )
-        return false;
-    }
-
-    std::string saveFileVersionStr;
-    uint16_t saveFileVersion = 0;
-
-    fs >> saveFileVersionStr >> saveFileVersion;
-
-    DEBUG_LOG( DBG_GAME, DBG_TRACE, "Version of the file " << filePath << ": " << saveFileVersion )
-
-    if ( saveFileVersion > CURRENT_FORMAT_VERSION || saveFileVersion < LAST_SUPPORTED_FORMAT_VERSION ) {
-        return false;
-    }
-
-    SetVersionOfCurrentSaveFile( saveFileVersion );
-
     HeaderSAV header;
-    fs >> header;
-
-    if ( fs.fail() ) {
+    if ( !readSaveFileHeader( filePath, header ) ) {
         return false;
     }
 
@@ -379,6 +643,19 @@ std::string Game::GetSaveDir()
     return System::concatPath( System::concatPath( System::GetDataDirectory( "fheroes2" ), "files" ), "save" );
 }
 
+MapsFileInfoList Game::LoadSAV2FileInfos( const std::vector<std::string> & filePaths )
+{
+    // Save files are replaced atomically, but the up-to-date information about the save file being written in the background is needed.
+    waitForBackgroundSaving();
+
+    return saveFileHeaderCache.getFileInfos( filePaths );
+}
+
+std::string Game::GetCacheDir()
+{
+    return System::concatPath( System::concatPath( System::GetDataDirectory( "fheroes2" ), "files" ), "cache" );
+}
+
 std::string Game::GetSaveFileBaseName()
 {
     std::string baseName = Settings::Get().getCurrentMapInfo().name;
@@ -418,5 +695,14 @@ std::string Game::GetSaveFileExtension( const int gameType )
 
 bool Game::SaveCompletedCampaignScenario()
 {
-    return Save( System::concatPath( GetSaveDir(), GetSaveFileBaseName() ) + "_Complete" + GetSaveFileExtension() );
+    const std::string filePath = System::concatPath( GetSaveDir(), GetSaveFileBaseName() ) + "_Complete" + GetSaveFileExtension();
+
+    // These save files are kept for a long time, so the size of the file is preferred over the speed.
+    if ( !saveGame( filePath, Compression::Level::BEST ) ) {
+        return false;
+    }
+
+    SetLastSaveName( filePath );
+
+    return true;
 }
@@ -25,6 +25,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "game_mode.h"
 
@@ -46,9 +47,20 @@ namespace Game
     std::string GetSaveFileExtension();
     std::string GetSaveFileExtension( const int gameType );
 
+    // Returns the path to the directory with the data generated by the game which can be safely removed, like indices of map files.
+    std::string GetCacheDir();
+
+    // The game data is serialized immediately, but the save file is written in the background.
     bool AutoSave();
     bool QuickSave();
 
+    // Waits for the save file being written in the background (if any) to be completed.
+    void waitForBackgroundSaving();
+
+    // Waits for the save file being written in the background (if any) to be completed and stops the background saving.
+    // Must be called before the application exits.
+    void stopBackgroundSaving();
+
     bool Save( const std::string & filePath, const bool autoSave = false );
 
     // Returns GameMode::CANCEL in case of failure.
@@ -56,5 +68,9 @@ namespace Game
 
     bool LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo );
 
+    // Returns the information about the given save files which can be loaded in the current game mode. Save files are read in parallel
+    // and the information about them is cached, so a save file is read again only after it is modified.
+    std::vector<Maps::FileInfo> LoadSAV2FileInfos( const std::vector<std::string> & filePaths );
+
     bool SaveCompletedCampaignScenario();
 }
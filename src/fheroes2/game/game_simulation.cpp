@@ -0,0 +1,626 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "game.h" // IWYU pragma: associated
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ai_planner.h"
+#include "army.h"
+#include "army_troop.h"
+#include "battle.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_board.h"
+#include "battle_cell.h"
+#include "battle_troop.h"
+#include "color.h"
+#include "game_mode.h"
+#include "game_over.h"
+#include "ground.h"
+#include "heroes.h"
+#include "kingdom.h"
+#include "logging.h"
+#include "maps_fileinfo.h"
+#include "math_base.h"
+#include "monster.h"
+#include "players.h"
+#include "rand.h"
+#include "resource.h"
+#include "settings.h"
+#include "timing.h"
+#include "tools.h"
+#include "world.h"
+#include "world_pathfinding.h"
+
+namespace
+{
+    bool isKingdomAlive( const Kingdom & kingdom )
+    {
+        return kingdom.isPlay() && !kingdom.isLoss();
+    }
+
+    bool loadMapInfo( const std::string & mapFilePath, Maps::FileInfo & mapInfo )
+    {
+        const std::string lowerCasePath = StringLower( mapFilePath );
+        const std::string_view resurrectionMapExtension{ ".fh2m" };
+
+        if ( lowerCasePath.size() > resurrectionMapExtension.size()
+             && lowerCasePath.compare( lowerCasePath.size() - resurrectionMapExtension.size(), resurrectionMapExtension.size(), resurrectionMapExtension ) == 0 ) {
+            return mapInfo.readResurrectionMap( mapFilePath, false );
+        }
+
+        return mapInfo.readMP2Map( mapFilePath, false );
+    }
+
+    bool loadWorld( const Maps::FileInfo & mapInfo )
+    {
+        if ( mapInfo.version == GameVersion::RESURRECTION ) {
+            return world.loadResurrectionMap( mapInfo.filename );
+        }
+
+        return world.LoadMapMP2( mapInfo.filename, ( mapInfo.version == GameVersion::SUCCESSION_WARS ) );
+    }
+
+    // Loads the given map as a standard game in which all players are controlled by AI
+    bool loadMapForAIPlayers( const std::string & mapFilePath, Maps::FileInfo & mapInfo )
+    {
+        if ( !loadMapInfo( mapFilePath, mapInfo ) ) {
+            ERROR_LOG( "Failed to read the map file '" << mapFilePath << "'." )
+            return false;
+        }
+
+        Settings & conf = Settings::Get();
+
+        conf.SetGameType( Game::TYPE_STANDARD );
+        conf.setCurrentMapInfo( mapInfo );
+
+        // Nobody is watching so there is no reason to show any movement of AI heroes.
+        conf.SetAIMoveSpeed( 0 );
+
+        Players & players = conf.GetPlayers();
+        for ( Player * player : players ) {
+            assert( player != nullptr );
+
+            player->SetControl( CONTROL_AI );
+        }
+
+        players.SetStartGame();
+
+        if ( !loadWorld( conf.getCurrentMapInfo() ) ) {
+            ERROR_LOG( "Failed to load the map '" << mapFilePath << "'." )
+            return false;
+        }
+
+        return true;
+    }
+
+    // The standard game over logic is built around human players, so for AI-only games it is enough to check
+    // whether all kingdoms that are still in the game belong to the same alliance.
+    bool isOnlyOneAllianceLeft( const std::vector<Player *> & players )
+    {
+        PlayerColorsSet aliveColors = 0;
+
+        for ( const Player * player : players ) {
+            if ( isKingdomAlive( world.GetKingdom( player->GetColor() ) ) ) {
+                aliveColors |= player->GetColor();
+            }
+        }
+
+        if ( aliveColors == 0 ) {
+            return true;
+        }
+
+        const Player * firstAlivePlayer = Players::Get( Color::GetFirst( aliveColors ) );
+        assert( firstAlivePlayer != nullptr );
+
+        return ( firstAlivePlayer->GetFriends() & aliveColors ) == aliveColors;
+    }
+
+    std::string escapeJsonString( const std::string & str )
+    {
+        std::string result;
+        result.reserve( str.size() );
+
+        for ( const char c : str ) {
+            if ( c == '"' || c == '\\' ) {
+                result += '\\';
+                result += c;
+            }
+            else if ( static_cast<unsigned char>( c ) < 0x20 ) {
+                result += ' ';
+            }
+            else {
+                result += c;
+            }
+        }
+
+        return result;
+    }
+
+    void outputResult( const Maps::FileInfo & mapInfo, const std::vector<Player *> & players, const bool isGameOver )
+    {
+        std::cout << "{\"map\":\"" << escapeJsonString( mapInfo.name ) << "\",\"seed\":" << world.GetMapSeed() << ",\"days\":" << world.CountDay()
+                  << ",\"finished\":" << ( isGameOver ? "true" : "false" ) << ",\"kingdoms\":[";
+
+        bool isFirst = true;
+
+        for ( const Player * player : players ) {
+            const Kingdom & kingdom = world.GetKingdom( player->GetColor() );
+
+            if ( !isFirst ) {
+                std::cout << ',';
+            }
+            isFirst = false;
+
+            std::cout << "{\"color\":\"" << escapeJsonString( Color::String( kingdom.GetColor() ) ) << "\",\"alive\":" << ( isKingdomAlive( kingdom ) ? "true" : "false" )
+                      << ",\"castles\":" << kingdom.GetCastles().size() << ",\"heroes\":" << kingdom.GetHeroes().size()
+                      << ",\"gold\":" << kingdom.GetFunds().Get( Resource::GOLD ) << ",\"armyStrength\":" << kingdom.GetArmiesStrength() << '}';
+        }
+
+        std::cout << "]}" << std::endl;
+    }
+
+    // Battles are played on the same tile as in the Battle Only mode
+    const int32_t battleTileIndex = 1;
+
+    const std::array<PlayerColor, 2> battleArmyColors{ PlayerColor::BLUE, PlayerColor::RED };
+
+    struct ArmySpec
+    {
+        int heroId{ Heroes::UNKNOWN };
+        std::vector<std::pair<int, uint32_t>> troops;
+    };
+
+    // The army is described as '[<hero id>/]<monster id>:<count>[,<monster id>:<count>...]'
+    std::optional<ArmySpec> parseArmySpec( std::string_view spec )
+    {
+        ArmySpec result;
+
+        if ( const size_t heroDelimiterPos = spec.find( '/' ); heroDelimiterPos != std::string_view::npos ) {
+            uint32_t heroId = 0;
+            if ( !fheroes2::parseNumber( spec.substr( 0, heroDelimiterPos ), heroId ) || !Heroes::isValidId( static_cast<int>( heroId ) ) ) {
+                return {};
+            }
+
+            result.heroId = static_cast<int>( heroId );
+            spec.remove_prefix( heroDelimiterPos + 1 );
+        }
+
+        while ( !spec.empty() ) {
+            const size_t troopDelimiterPos = spec.find( ',' );
+            const std::string_view troopSpec = spec.substr( 0, troopDelimiterPos );
+
+            spec.remove_prefix( troopDelimiterPos == std::string_view::npos ? spec.size() : troopDelimiterPos + 1 );
+
+            const size_t countDelimiterPos = troopSpec.find( ':' );
+            if ( countDelimiterPos == std::string_view::npos ) {
+                return {};
+            }
+
+            uint32_t monsterId = 0;
+            uint32_t count = 0;
+            if ( !fheroes2::parseNumber( troopSpec.substr( 0, countDelimiterPos ), monsterId )
+                 || !fheroes2::parseNumber( troopSpec.substr( countDelimiterPos + 1 ), count ) || count == 0 ) {
+                return {};
+            }
+
+            if ( !Monster( static_cast<int>( monsterId ) ).isValid() ) {
+                return {};
+            }
+
+            result.troops.emplace_back( static_cast<int>( monsterId ), count );
+        }
+
+        if ( result.troops.empty() || result.troops.size() > Army::maximumTroopCount ) {
+            return {};
+        }
+
+        return result;
+    }
+
+    // Returns the army described by the given spec. The army is either the army of a hero, or the given army without a commander.
+    Army * prepareBattleArmy( const ArmySpec & spec, const size_t armyIdx, Army & armyWithoutCommander )
+    {
+        const PlayerColor color = battleArmyColors[armyIdx];
+
+        Army * army = &armyWithoutCommander;
+
+        if ( spec.heroId != Heroes::UNKNOWN ) {
+            Heroes * hero = world.GetHeroes( spec.heroId );
+            if ( hero == nullptr || hero->GetColor() != PlayerColor::NONE ) {
+                return nullptr;
+            }
+
+            Players::SetPlayerRace( color, hero->GetRace() );
+
+            const int32_t position = static_cast<int32_t>( armyIdx );
+            if ( !hero->Recruit( color, { position, position } ) ) {
+                return nullptr;
+            }
+
+            army = &hero->GetArmy();
+        }
+        else {
+            army->SetColor( color );
+        }
+
+        army->Reset();
+
+        for ( size_t troopIdx = 0; troopIdx < spec.troops.size(); ++troopIdx ) {
+            army->GetTroop( troopIdx )->Set( Monster( spec.troops[troopIdx].first ), spec.troops[troopIdx].second );
+        }
+
+        return army;
+    }
+
+    // Prepares the world for the battles between the armies described by the given specs. Returns false if any of the armies cannot be created.
+    bool prepareBattleArmies( const std::string & attackingArmySpec, const std::string & defendingArmySpec, std::array<Army, 2> & armiesWithoutCommander,
+                              std::array<Army *, 2> & armies )
+    {
+        const std::array<std::optional<ArmySpec>, 2> armySpecs{ parseArmySpec( attackingArmySpec ), parseArmySpec( defendingArmySpec ) };
+
+        for ( size_t armyIdx = 0; armyIdx < armySpecs.size(); ++armyIdx ) {
+            if ( !armySpecs[armyIdx] ) {
+                ERROR_LOG( "Invalid army description: '" << ( armyIdx == 0 ? attackingArmySpec : defendingArmySpec ) << "'." )
+                return false;
+            }
+        }
+
+        Settings & conf = Settings::Get();
+        conf.SetGameType( Game::TYPE_BATTLEONLY );
+
+        // The terrain is fixed so that only the seed affects the battlefield
+        world.generateBattleOnlyMap( Maps::Ground::GRASS );
+
+        conf.GetPlayers().Init( battleArmyColors[0] | battleArmyColors[1] );
+        world.InitKingdoms();
+
+        for ( size_t armyIdx = 0; armyIdx < armies.size(); ++armyIdx ) {
+            Players::SetPlayerControl( battleArmyColors[armyIdx], CONTROL_AI );
+
+            armies[armyIdx] = prepareBattleArmy( *armySpecs[armyIdx], armyIdx, armiesWithoutCommander[armyIdx] );
+            if ( armies[armyIdx] == nullptr ) {
+                ERROR_LOG( "Failed to create the army: '" << ( armyIdx == 0 ? attackingArmySpec : defendingArmySpec ) << "'." )
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    double getForceStrength( const Battle::Force & force )
+    {
+        double strength = 0;
+
+        for ( const Battle::Unit * unit : force ) {
+            assert( unit != nullptr );
+
+            if ( unit->isValid() ) {
+                strength += unit->GetStrength();
+            }
+        }
+
+        return strength;
+    }
+
+    struct BattleArmyStats
+    {
+        uint32_t wins{ 0 };
+
+        // The sum of shares of the army strength lost in each battle
+        double lostStrengthShare{ 0 };
+    };
+
+    void updateBattleArmyStats( BattleArmyStats & stats, const bool isWinner, const double initialStrength, const double finalStrength )
+    {
+        if ( isWinner ) {
+            ++stats.wins;
+        }
+
+        if ( initialStrength > 0 ) {
+            stats.lostStrengthShare += ( initialStrength - finalStrength ) / initialStrength;
+        }
+    }
+
+    void outputBattleArmyStats( const char * name, const BattleArmyStats & stats, const uint32_t battleCount )
+    {
+        std::cout << '"' << name << "\":{\"wins\":" << stats.wins << ",\"winRate\":" << static_cast<double>( stats.wins ) / battleCount
+                  << ",\"averageLosses\":" << stats.lostStrengthShare / battleCount << '}';
+    }
+
+    // Returns the time in seconds it took to evaluate the given heroes the given number of times
+    template <typename Pathfinder>
+    double measureWorldPathfinder( const std::vector<const Heroes *> & heroes, const uint32_t runCount )
+    {
+        Pathfinder pathfinder;
+
+        const fheroes2::Time timer;
+
+        for ( uint32_t run = 0; run < runCount; ++run ) {
+            for ( const Heroes * hero : heroes ) {
+                // Otherwise, the pathfinder will only repair its cache or won't do anything at all
+                pathfinder.reset();
+                pathfinder.reEvaluateIfNeeded( *hero );
+            }
+        }
+
+        return timer.getS();
+    }
+
+    void outputPathfinderTime( const char * name, const double time, const size_t evaluationCount )
+    {
+        std::cout << '"' << name << "\":{\"totalMs\":" << time * 1000 << ",\"evaluationMs\":" << time * 1000 / static_cast<double>( evaluationCount ) << '}';
+    }
+}
+
+bool Game::runAISimulation( const std::string & mapFilePath, const uint32_t maxDays )
+{
+    Maps::FileInfo mapInfo;
+    if ( !loadMapForAIPlayers( mapFilePath, mapInfo ) ) {
+        return false;
+    }
+
+    Settings & conf = Settings::Get();
+    Players & players = conf.GetPlayers();
+
+    GameOver::Result::Get().Reset();
+
+    std::vector<Player *> sortedPlayers = players.getVector();
+    std::sort( sortedPlayers.begin(), sortedPlayers.end(), []( const Player * first, const Player * second ) { return first->GetColor() < second->GetColor(); } );
+
+    for ( const Player * player : sortedPlayers ) {
+        world.ClearFog( player->GetColor() );
+    }
+
+    bool isGameOver = false;
+
+    while ( !isGameOver && ( maxDays == 0 || world.CountDay() < maxDays ) ) {
+        world.NewDay();
+
+        for ( const Player * player : sortedPlayers ) {
+            Kingdom & kingdom = world.GetKingdom( player->GetColor() );
+            if ( !kingdom.isPlay() ) {
+                continue;
+            }
+
+            DEBUG_LOG( DBG_GAME, DBG_INFO, world.DateString() << ", color: " << Color::String( player->GetColor() ) << ", resource: " << kingdom.GetFunds().String() )
+
+            conf.SetCurrentColor( player->GetColor() );
+
+            kingdom.ActionNewDayResourceUpdate( nullptr );
+            kingdom.ActionBeforeTurn();
+
+            AI::Planner::Get().KingdomTurn( kingdom );
+
+            if ( isOnlyOneAllianceLeft( sortedPlayers ) ) {
+                isGameOver = true;
+                break;
+            }
+        }
+
+        conf.SetCurrentColor( PlayerColor::NONE );
+    }
+
+    outputResult( mapInfo, sortedPlayers, isGameOver );
+
+    return true;
+}
+
+bool Game::runBattleSimulation( const std::string & attackingArmySpec, const std::string & defendingArmySpec, const uint32_t firstSeed, const uint32_t battleCount )
+{
+    if ( battleCount == 0 ) {
+        ERROR_LOG( "The number of battles should be greater than 0." )
+        return false;
+    }
+
+    std::array<Army, 2> armiesWithoutCommander;
+    std::array<Army *, 2> armies{};
+
+    if ( !prepareBattleArmies( attackingArmySpec, defendingArmySpec, armiesWithoutCommander, armies ) ) {
+        return false;
+    }
+
+    Army & attackingArmy = *armies[0];
+    Army & defendingArmy = *armies[1];
+
+    BattleArmyStats attackerStats;
+    BattleArmyStats defenderStats;
+    uint64_t totalTurns = 0;
+
+    // Each battle uses its own instance of the arena and its own random generator, but the arena relies on the global state (world, players,
+    // AI planner), so battles are played one after another.
+    for ( uint32_t battleNumber = 0; battleNumber < battleCount; ++battleNumber ) {
+        for ( Army * army : armies ) {
+            HeroBase * commander = army->GetCommander();
+            if ( commander != nullptr ) {
+                commander->SetSpellPoints( commander->GetMaxSpellPoints() );
+            }
+        }
+
+        Rand::PCG32 randomGenerator( firstSeed + battleNumber );
+        Battle::Arena arena( attackingArmy, defendingArmy, battleTileIndex, false, randomGenerator );
+
+        const double attackerInitialStrength = getForceStrength( arena.getAttackingForce() );
+        const double defenderInitialStrength = getForceStrength( arena.getDefendingForce() );
+
+        while ( arena.BattleValid() ) {
+            arena.Turns();
+        }
+
+        const Battle::Result & result = arena.GetResult();
+
+        updateBattleArmyStats( attackerStats, result.isAttackerWin(), attackerInitialStrength, getForceStrength( arena.getAttackingForce() ) );
+        updateBattleArmyStats( defenderStats, result.isDefenderWin(), defenderInitialStrength, getForceStrength( arena.getDefendingForce() ) );
+
+        totalTurns += arena.GetTurnNumber();
+
+        DEBUG_LOG( DBG_BATTLE, DBG_INFO,
+                   "battle " << battleNumber << ", attacker: " << ( result.isAttackerWin() ? "wins" : "loss" ) << ", turns: " << arena.GetTurnNumber() )
+    }
+
+    std::cout << "{\"battles\":" << battleCount << ",\"firstSeed\":" << firstSeed << ',';
+    outputBattleArmyStats( "attacker", attackerStats, battleCount );
+    std::cout << ',';
+    outputBattleArmyStats( "defender", defenderStats, battleCount );
+    std::cout << ",\"averageTurns\":" << static_cast<double>( totalTurns ) / battleCount << '}' << std::endl;
+
+    return true;
+}
+
+bool Game::runWorldPathfindingBenchmark( const std::string & mapFilePath, const uint32_t runCount )
+{
+    if ( runCount == 0 ) {
+        ERROR_LOG( "The number of runs should be greater than 0." )
+        return false;
+    }
+
+    Maps::FileInfo mapInfo;
+    if ( !loadMapForAIPlayers( mapFilePath, mapInfo ) ) {
+        return false;
+    }
+
+    std::vector<const Heroes *> heroes;
+
+    // Movement points of heroes are changed only for the time of the benchmark, the map should stay as it was loaded
+    std::vector<std::pair<Heroes *, uint32_t>> originalMovePoints;
+
+    for ( const Player * player : Settings::Get().GetPlayers() ) {
+        for ( Heroes * hero : world.GetKingdom( player->GetColor() ).GetHeroes() ) {
+            assert( hero != nullptr );
+
+            originalMovePoints.emplace_back( hero, hero->GetMovePoints() );
+
+            // Heroes should have the same number of movement points as at the beginning of a turn
+            hero->ResetMovePoints();
+            hero->IncreaseMovePoints( hero->GetMaxMovePoints() );
+
+            heroes.push_back( hero );
+        }
+    }
+
+    if ( heroes.empty() ) {
+        ERROR_LOG( "There are no heroes on the map '" << mapFilePath << "'." )
+        return false;
+    }
+
+    const double playerPathfinderTime = measureWorldPathfinder<PlayerWorldPathfinder>( heroes, runCount );
+    const double aiPathfinderTime = measureWorldPathfinder<AIWorldPathfinder>( heroes, runCount );
+
+    for ( const auto & [hero, movePoints] : originalMovePoints ) {
+        hero->ResetMovePoints();
+        hero->IncreaseMovePoints( movePoints );
+    }
+
+    const size_t evaluationCount = heroes.size() * runCount;
+
+    std::cout << "{\"map\":\"" << escapeJsonString( mapInfo.name ) << "\",\"tiles\":" << world.getSize() << ",\"heroes\":" << heroes.size()
+              << ",\"runs\":" << runCount << ',';
+    outputPathfinderTime( "player", playerPathfinderTime, evaluationCount );
+    std::cout << ',';
+    outputPathfinderTime( "ai", aiPathfinderTime, evaluationCount );
+    std::cout << '}' << std::endl;
+
+    return true;
+}
+
+bool Game::runBattlePathfindingBenchmark( const std::string & attackingArmySpec, const std::string & defendingArmySpec, const uint32_t runCount )
+{
+    if ( runCount == 0 ) {
+        ERROR_LOG( "The number of runs should be greater than 0." )
+        return false;
+    }
+
+    std::array<Army, 2> armiesWithoutCommander;
+    std::array<Army *, 2> armies{};
+
+    if ( !prepareBattleArmies( attackingArmySpec, defendingArmySpec, armiesWithoutCommander, armies ) ) {
+        return false;
+    }
+
+    Rand::PCG32 randomGenerator( 0 );
+    Battle::Arena arena( *armies[0], *armies[1], battleTileIndex, false, randomGenerator );
+
+    std::vector<const Battle::Unit *> units;
+
+    for ( const Battle::Force * force : { &arena.getAttackingForce(), &arena.getDefendingForce() } ) {
+        for ( const Battle::Unit * unit : *force ) {
+            assert( unit != nullptr );
+
+            if ( unit->isValid() ) {
+                units.push_back( unit );
+            }
+        }
+    }
+
+    // The pathfinder graph is rebuilt only when the pathfinder is used for another unit, so there should be at least two units
+    // to rebuild it on every evaluation. Each army has at least one unit.
+    assert( units.size() > 1 );
+
+    // The number of available moves and reachable positions is written to the output so that the results of different versions
+    // of the pathfinder can be compared with each other
+    size_t availableMoveCount = 0;
+    size_t reachablePositionCount = 0;
+
+    const fheroes2::Time availableMovesTimer;
+
+    for ( uint32_t run = 0; run < runCount; ++run ) {
+        for ( const Battle::Unit * unit : units ) {
+            availableMoveCount += arena.getAllAvailableMoves( *unit ).size();
+        }
+    }
+
+    const double availableMovesTime = availableMovesTimer.getS();
+
+    const fheroes2::Time reachabilityTimer;
+
+    for ( uint32_t run = 0; run < runCount; ++run ) {
+        for ( const Battle::Unit * unit : units ) {
+            for ( int32_t cellIdx = 0; cellIdx < Battle::Board::sizeInCells; ++cellIdx ) {
+                if ( arena.isPositionReachable( *unit, Battle::Position::GetPosition( *unit, cellIdx ), false ) ) {
+                    ++reachablePositionCount;
+                }
+            }
+        }
+    }
+
+    const double reachabilityTime = reachabilityTimer.getS();
+
+    const size_t evaluationCount = units.size() * runCount;
+
+    std::cout << "{\"units\":" << units.size() << ",\"runs\":" << runCount << ",\"availableMoves\":" << availableMoveCount / runCount
+              << ",\"reachablePositions\":" << reachablePositionCount / runCount << ',';
+    outputPathfinderTime( "getAllAvailableMoves", availableMovesTime, evaluationCount );
+    std::cout << ',';
+    outputPathfinderTime( "isPositionReachable", reachabilityTime, evaluationCount );
+    std::cout << '}' << std::endl;
+
+    return true;
+}
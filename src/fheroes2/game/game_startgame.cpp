@@ -28,6 +28,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -77,12 +78,14 @@
 #include "resource.h"
 #include "screen.h"
 #include "settings.h"
+#include "til.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_dialog.h"
 #include "ui_language.h"
 #include "ui_text.h"
 #include "ui_tool.h"
+#include "view_world.h"
 #include "week.h"
 #include "world.h"
 
@@ -208,6 +211,24 @@ namespace
             Game::DialogPlayers( myKingdom.GetColor(), _( "Beware!" ), str );
         }
     }
+
+    // Unloads the images not used recently until all images fit into the given memory limit in bytes (0 means no limit).
+    void evictUnusedImages( const size_t memoryLimit )
+    {
+        if ( memoryLimit == 0 ) {
+            // Only the images of the View World window rendered for another map are removed.
+            ViewWorld::reduceCachedImagesMemoryUsage( std::numeric_limits<size_t>::max() );
+            fheroes2::AGG::evictUnusedResources( 0 );
+            return;
+        }
+
+        // The images of the View World window are counted against the same limit. They are removed first since the resources are required
+        // much more often than the world map.
+        const size_t resourceMemoryUsage = fheroes2::AGG::getResourceMemoryUsage();
+        const size_t viewWorldMemoryUsage = ViewWorld::reduceCachedImagesMemoryUsage( resourceMemoryUsage < memoryLimit ? memoryLimit - resourceMemoryUsage : 0 );
+
+        fheroes2::AGG::evictUnusedResources( std::max<size_t>( memoryLimit - viewWorldMemoryUsage, 1 ) );
+    }
 }
 
 fheroes2::GameMode Game::StartBattleOnly()
@@ -740,6 +761,9 @@ fheroes2::GameMode Interface::AdventureMap::StartGame()
         conf.SetCurrentColor( static_cast<PlayerColor>( Players::HumanColors() ) );
     }
 
+    // Decode the terrain images in the background while the radar is being built.
+    fheroes2::AGG::preloadResources( {}, { TIL::GROUND32, TIL::CLOF32, TIL::STON } );
+
     reset();
 
     _radar.Build();
@@ -849,6 +873,9 @@ fheroes2::GameMode Interface::AdventureMap::StartGame()
                         Game::DialogPlayers( playerColor, "", _( "%{color} player's turn." ) );
                     }
 
+                    // No images are being referenced at this moment so the images not used during the previous turn can be safely unloaded.
+                    evictUnusedImages( static_cast<size_t>( conf.imageCacheMemoryLimit() ) * 1024 * 1024 );
+
                     kingdom.ActionBeforeTurn();
 
                     _iconsPanel.showIcons( ICON_ANY );
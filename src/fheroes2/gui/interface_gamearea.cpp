@@ -25,12 +25,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <deque>
 #include <list>
 #include <map>
 #include <ostream>
 #include <type_traits>
+#include <vector>
 
 #include "agg_image.h"
 #include "castle.h"
@@ -321,6 +323,9 @@ namespace
 
         return false;
     }
+
+    // Size of a side of a terrain chunk in tiles.
+    const int32_t terrainChunkSize = 8;
 }
 
 Interface::GameArea::GameArea( BaseInterface & interface )
@@ -403,6 +408,71 @@ void Interface::GameArea::DrawTile( fheroes2::Image & dst, const fheroes2::Image
     fheroes2::Copy( src, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width, overlappedRoi.height );
 }
 
+void Interface::GameArea::_renderTerrainChunks( fheroes2::Image & dst, const fheroes2::Rect & tileRoi ) const
+{
+    const int32_t worldWidth = world.w();
+    const int32_t worldHeight = world.h();
+
+    const fheroes2::Size chunkCount{ ( worldWidth + terrainChunkSize - 1 ) / terrainChunkSize, ( worldHeight + terrainChunkSize - 1 ) / terrainChunkSize };
+    if ( chunkCount != _terrainChunkCount || world.getMapGeneration() != _terrainChunksMapGeneration ) {
+        // Another map has been loaded.
+        _terrainChunks.clear();
+        _terrainChunks.resize( static_cast<size_t>( chunkCount.width ) * chunkCount.height );
+        _terrainChunkCount = chunkCount;
+        _terrainChunksMapGeneration = world.getMapGeneration();
+    }
+
+    for ( const int32_t tileIndex : world.takeTerrainChangedTiles() ) {
+        const fheroes2::Point tilePos = Maps::GetPoint( tileIndex );
+
+        _terrainChunks[tilePos.x / terrainChunkSize + tilePos.y / terrainChunkSize * chunkCount.width].isChanged = true;
+    }
+
+    const int32_t minChunkX = tileRoi.x / terrainChunkSize;
+    const int32_t minChunkY = tileRoi.y / terrainChunkSize;
+    const int32_t maxChunkX = ( tileRoi.x + tileRoi.width - 1 ) / terrainChunkSize;
+    const int32_t maxChunkY = ( tileRoi.y + tileRoi.height - 1 ) / terrainChunkSize;
+
+    for ( int32_t chunkY = 0; chunkY < chunkCount.height; ++chunkY ) {
+        for ( int32_t chunkX = 0; chunkX < chunkCount.width; ++chunkX ) {
+            TerrainChunk & chunk = _terrainChunks[chunkX + chunkY * chunkCount.width];
+
+            if ( chunkX < minChunkX - 1 || chunkX > maxChunkX + 1 || chunkY < minChunkY - 1 || chunkY > maxChunkY + 1 ) {
+                // Keep in memory only the chunks which are visible or close to the visible area to avoid having a copy of the whole world map.
+                if ( !chunk.image.empty() ) {
+                    chunk.image.clear();
+                }
+                continue;
+            }
+
+            if ( chunkX < minChunkX || chunkX > maxChunkX || chunkY < minChunkY || chunkY > maxChunkY ) {
+                continue;
+            }
+
+            const fheroes2::Rect chunkTileRoi{ chunkX * terrainChunkSize, chunkY * terrainChunkSize, std::min( terrainChunkSize, worldWidth - chunkX * terrainChunkSize ),
+                                               std::min( terrainChunkSize, worldHeight - chunkY * terrainChunkSize ) };
+
+            if ( chunk.image.empty() || chunk.isChanged ) {
+                if ( chunk.image.empty() ) {
+                    chunk.image._disableTransformLayer();
+                    chunk.image.resize( chunkTileRoi.width * fheroes2::tileWidthPx, chunkTileRoi.height * fheroes2::tileWidthPx );
+                }
+
+                for ( int32_t y = 0; y < chunkTileRoi.height; ++y ) {
+                    for ( int32_t x = 0; x < chunkTileRoi.width; ++x ) {
+                        Maps::renderTileGround( world.getTile( chunkTileRoi.x + x, chunkTileRoi.y + y ), chunk.image,
+                                                { x * fheroes2::tileWidthPx, y * fheroes2::tileWidthPx } );
+                    }
+                }
+
+                chunk.isChanged = false;
+            }
+
+            DrawTile( dst, chunk.image, chunkTileRoi.getPosition() );
+        }
+    }
+}
+
 void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw ) const
 {
     const fheroes2::Rect & tileROI = GetVisibleTileROI();
@@ -418,6 +488,10 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     const bool renderFog = ( flag & LEVEL_FOG ) == LEVEL_FOG;
 #endif
 
+    // Terrain and static objects below the object layer are taken from the pre-rendered terrain chunks. Puzzle map hides some of these objects,
+    // so it is rendered directly as it is rarely shown.
+    const bool useTerrainChunks = !isPuzzleDraw;
+
     // Render terrain.
     for ( int32_t y = 0; y < tileROI.height; ++y ) {
         fheroes2::Point offset( tileROI.x, tileROI.y + y );
@@ -432,7 +506,7 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
                 if ( offset.x < 0 || offset.x >= worldWidth ) {
                     Maps::redrawEmptyTile( dst, offset, *this );
                 }
-                else {
+                else if ( !useTerrainChunks ) {
                     const Maps::Tile & tile = world.getTile( offset.x, offset.y );
                     // Do not render terrain on the tiles fully covered with the fog.
                     if ( !renderFog || tile.getFogDirection() != DIRECTION_ALL ) {
@@ -596,7 +670,14 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
         }
     }
 
-    // Render all terrain and background layer object.
+    // Tiles whose objects below the object layer are rendered directly instead of being taken from the terrain chunks.
+    std::vector<int32_t> groundTilesToRender;
+    groundTilesToRender.reserve( static_cast<size_t>( maxX - minX ) * ( maxY - minY ) );
+
+    if ( useTerrainChunks ) {
+        _renderTerrainChunks( dst, { minX, minY, maxX - minX, maxY - minY } );
+    }
+
     for ( int32_t y = minY; y < maxY; ++y ) {
         const int32_t offset = y * worldWidth;
         for ( int32_t x = minX; x < maxX; ++x ) {
@@ -606,27 +687,34 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
                 continue;
             }
 
-            // Draw roads, rivers and cracks.
-            redrawBottomLayerObjects( tile, dst, isPuzzleDraw, *this, Maps::TERRAIN_LAYER );
+            // Animated or fading objects as well as the lower parts of tile-unfit objects require the tile to be rendered every time.
+            if ( useTerrainChunks && isTileGroundStatic( tile, *this ) && tileUnfit.bottomBackgroundImages.count( { x, y } ) == 0 ) {
+                continue;
+            }
 
-            redrawBottomLayerObjects( tile, dst, isPuzzleDraw, *this, Maps::BACKGROUND_LAYER );
+            groundTilesToRender.emplace_back( x + offset );
         }
     }
 
-    // Draw the lower part of tile-unfit object's sprite.
-    renderImagesOnTiles( dst, tileUnfit.bottomBackgroundImages, *this );
+    // Render all terrain and background layer object.
+    for ( const int32_t tileIndex : groundTilesToRender ) {
+        const Maps::Tile & tile = world.getTile( tileIndex );
 
-    for ( int32_t y = minY; y < maxY; ++y ) {
-        const int32_t offset = y * worldWidth;
-        for ( int32_t x = minX; x < maxX; ++x ) {
-            const Maps::Tile & tile = world.getTile( x + offset );
+        if ( useTerrainChunks ) {
+            DrawTile( dst, getTileSurface( tile ), Maps::GetPoint( tileIndex ) );
+        }
 
-            if ( renderFog && ( tile.getFogDirection() == DIRECTION_ALL ) ) {
-                continue;
-            }
+        // Draw roads, rivers and cracks.
+        redrawBottomLayerObjects( tile, dst, isPuzzleDraw, *this, Maps::TERRAIN_LAYER );
 
-            redrawBottomLayerObjects( tile, dst, isPuzzleDraw, *this, Maps::SHADOW_LAYER );
-        }
+        redrawBottomLayerObjects( tile, dst, isPuzzleDraw, *this, Maps::BACKGROUND_LAYER );
+    }
+
+    // Draw the lower part of tile-unfit object's sprite.
+    renderImagesOnTiles( dst, tileUnfit.bottomBackgroundImages, *this );
+
+    for ( const int32_t tileIndex : groundTilesToRender ) {
+        redrawBottomLayerObjects( world.getTile( tileIndex ), dst, isPuzzleDraw, *this, Maps::SHADOW_LAYER );
     }
 
     // Draw all shadows from tile-unfit objects.
@@ -289,6 +289,20 @@ namespace Interface
         // This member needs to be mutable because it is modified during rendering.
         mutable std::vector<std::shared_ptr<BaseObjectAnimationInfo>> _animationInfo;
 
+        // Pre-rendered terrain, roads, rivers, background objects and shadows of a square area of the world map.
+        struct TerrainChunk
+        {
+            fheroes2::Image image;
+
+            // Some tiles of the chunk have been changed after the image was rendered.
+            bool isChanged{ false };
+        };
+
+        // These members need to be mutable because they are updated during rendering.
+        mutable std::vector<TerrainChunk> _terrainChunks;
+        mutable fheroes2::Size _terrainChunkCount;
+        mutable uint32_t _terrainChunksMapGeneration{ 0 };
+
         fheroes2::Point _lastMouseDragPosition;
         fheroes2::Point _mousePositionForFastScroll;
         bool _mouseDraggingInitiated{ false };
@@ -308,5 +322,8 @@ namespace Interface
         void _setCenterToTile( const fheroes2::Point & tile ); // set center to the middle of tile (input is tile ID)
 
         void updateObjectAnimationInfo() const;
+
+        // Renders the terrain chunks covering the given area of tiles, re-rendering the chunks whose tiles have been changed.
+        void _renderTerrainChunks( fheroes2::Image & dst, const fheroes2::Rect & tileRoi ) const;
     };
 }
@@ -25,6 +25,8 @@
 
 #include <cassert>
 #include <cstring>
+#include <ostream>
+#include <vector>
 
 #include "agg_image.h"
 #include "castle.h"
@@ -35,6 +37,7 @@
 #include "interface_base.h"
 #include "interface_gamearea.h"
 #include "localevent.h"
+#include "logging.h"
 #include "maps_tiles.h"
 #include "mp2.h"
 #include "players.h"
@@ -45,10 +48,6 @@
 #include "ui_dialog.h"
 #include "world.h"
 
-#ifdef WITH_DEBUG
-#include "logging.h"
-#endif
-
 namespace
 {
     enum : uint8_t
@@ -153,7 +152,6 @@ Interface::Radar::Radar( const Radar & radar, const fheroes2::Display & display
     : BorderWindow( { display.width() - fheroes2::borderWidthPx - fheroes2::radarWidthPx, fheroes2::borderWidthPx, fheroes2::radarWidthPx, fheroes2::radarWidthPx } )
     , _radarType( RadarType::ViewWorld )
     , _interface( radar._interface )
-    , _roi( 0, 0, world.w(), world.h() )
     , _zoom( radar._zoom )
     , _hide( false )
 {
@@ -178,7 +176,9 @@ void Interface::Radar::SetPos( int32_t x, int32_t y )
 void Interface::Radar::Build()
 {
     SetZoom();
-    _roi = { 0, 0, world.w(), world.h() };
+
+    // Another map has been loaded so the whole radar map image has to be redrawn.
+    _tileColors.clear();
 }
 
 void Interface::Radar::SetZoom()
@@ -204,12 +204,7 @@ void Interface::Radar::SetRedraw( const uint32_t redrawMode ) const
 
 void Interface::Radar::SetRenderArea( const fheroes2::Rect & roi )
 {
-    const Settings & conf = Settings::Get();
-    // We set ROI only if radar is visible as there will be no render of radar map image if it is hidden.
-    if ( !conf.isHideInterfaceEnabled() || conf.ShowRadar() ) {
-        // "_roi" should not be outside the "world".
-        _roi = roi ^ fheroes2::Rect( 0, 0, world.w(), world.h() );
-    }
+    world.markRadarAreaAsChanged( roi );
 }
 
 void Interface::Radar::_redraw( const bool redrawMapObjects )
@@ -221,9 +216,7 @@ void Interface::Radar::_redraw( const bool redrawMapObjects )
         }
         else {
             // We are in "Hide Interface" mode and radar is turned off so we have nothing to render.
-
-            // Force set radar ROI for the whole world to be prepared to fully update radar when it will be shown.
-            _roi = { 0, 0, world.w(), world.h() };
+            // The changed tiles are kept by the world until the radar is shown again.
             return;
         }
     }
@@ -232,9 +225,6 @@ void Interface::Radar::_redraw( const bool redrawMapObjects )
     const fheroes2::Rect & rect = GetArea();
     if ( _hide ) {
         fheroes2::Blit( fheroes2::AGG::GetICN( ( conf.isEvilInterfaceEnabled() ? ICN::HEROLOGE : ICN::HEROLOGO ), 0 ), display, rect.x, rect.y );
-
-        // Force set radar ROI for the whole world to be prepared to fully update radar when it will be shown.
-        _roi = { 0, 0, world.w(), world.h() };
     }
     else {
         _cursorArea.hide();
@@ -271,6 +261,9 @@ void Interface::Radar::redrawForEditor( const bool renderMapObjects )
     _cursorArea.hide();
 
     if ( renderMapObjects ) {
+        // The Editor modifies the ground and roads without informing the radar, so the whole radar map image is evaluated again.
+        _tileColors.clear();
+
         RedrawObjects( 0, ViewWorldMode::ViewAll );
         const fheroes2::Rect & rect = GetArea();
         fheroes2::Copy( _map, 0, 0, fheroes2::Display::instance(), rect.x, rect.y, _map.width(), _map.height() );
@@ -290,11 +283,24 @@ void Interface::Radar::RedrawObjects( const PlayerColorsSet playerColor, const V
 
     uint8_t * radarImage = _map.image();
 
-    assert( _roi.x >= 0 && _roi.y >= 0 && ( _roi.width + _roi.x ) <= world.w() && ( _roi.height + _roi.y ) <= world.h() );
+    const int32_t worldWidth = world.w();
+    const int32_t worldHeight = world.h();
+    const size_t tileCount = static_cast<size_t>( worldWidth ) * worldHeight;
 
-    // Fill the radar map with black color ( 0 ) only if we are redrawing the entire map.
-    if ( _roi.x == 0 && _roi.y == 0 && _roi.width == world.w() && _roi.height == world.h() ) {
+    // Only the radar of the Adventure Map takes the tiles changed in the world. The world is not changed while the View World window is open.
+    std::vector<int32_t> changedTiles;
+    if ( _radarType == RadarType::WorldMap ) {
+        changedTiles = world.takeRadarChangedTiles();
+    }
+
+    // Colors of tiles depend on the player and the mode, so the radar map image has to be fully redrawn if any of them has been changed.
+    const bool redrawAllTiles = ( _tileColors.size() != tileCount || _tileColorsPlayerColor != playerColor || _tileColorsMode != flags );
+    if ( redrawAllTiles ) {
         std::memset( radarImage, COLOR_BLACK, static_cast<size_t>( area.width ) * area.height );
+
+        _tileColors.assign( tileCount, COLOR_BLACK );
+        _tileColorsPlayerColor = playerColor;
+        _tileColorsMode = flags;
     }
 
     const bool revealMines = revealAll || ( flags == ViewWorldMode::ViewMines );
@@ -308,114 +314,125 @@ void Interface::Radar::RedrawObjects( const PlayerColorsSet playerColor, const V
 
     const bool isZoomIn = _zoom > 1.0;
 
-    const int32_t maxRoiX = _roi.width + _roi.x;
-    const int32_t maxRoiY = _roi.height + _roi.y;
+    [[maybe_unused]] uint32_t repaintedTileCount = 0;
 
-    const uint8_t * radarYEnd = nullptr;
+    const auto redrawTile = [&]( const int32_t x, const int32_t y ) {
+        const Maps::Tile & tile = world.getTile( x, y );
+        const bool visibleTile = revealAll || !tile.isFog( playerColor );
 
-    for ( int32_t y = _roi.y; y < maxRoiY; ++y ) {
-        uint8_t * radarY = radarImage + static_cast<size_t>( y * _zoom ) * radarWidth;
-        if ( isZoomIn ) {
-            radarYEnd = radarImage + static_cast<size_t>( ( y + 1 ) * _zoom ) * radarWidth;
-        }
-
-        for ( int32_t x = _roi.x; x < maxRoiX; ++x ) {
-            const Maps::Tile & tile = world.getTile( x, y );
-            const bool visibleTile = revealAll || !tile.isFog( playerColor );
+        uint8_t fillColor = COLOR_BLACK;
 
-            uint8_t fillColor = 0;
-
-            const MP2::MapObjectType objectType = tile.getMainObjectType( revealOnlyVisible || revealHeroes );
-            switch ( objectType ) {
-            case MP2::OBJ_HERO: {
-                if ( visibleTile || revealHeroes ) {
-                    const Heroes * hero = world.GetHeroes( { x, y } );
-                    if ( hero ) {
-                        fillColor = GetPaletteIndexFromColor( hero->GetColor() );
-                        break;
-                    }
+        const MP2::MapObjectType objectType = tile.getMainObjectType( revealOnlyVisible || revealHeroes );
+        switch ( objectType ) {
+        case MP2::OBJ_HERO: {
+            if ( visibleTile || revealHeroes ) {
+                const Heroes * hero = world.GetHeroes( { x, y } );
+                if ( hero ) {
+                    fillColor = GetPaletteIndexFromColor( hero->GetColor() );
                 }
-                continue;
             }
-            case MP2::OBJ_LIGHTHOUSE:
-            case MP2::OBJ_ALCHEMIST_LAB:
-            case MP2::OBJ_MINE:
-            case MP2::OBJ_SAWMILL:
-                // TODO: Why Lighthouse is in this category? Verify the logic!
-                if ( visibleTile || revealMines ) {
-                    fillColor = GetPaletteIndexFromColor( world.ColorCapturedObject( tile.GetIndex() ) );
-                    break;
+            break;
+        }
+        case MP2::OBJ_LIGHTHOUSE:
+        case MP2::OBJ_ALCHEMIST_LAB:
+        case MP2::OBJ_MINE:
+        case MP2::OBJ_SAWMILL:
+            // TODO: Why Lighthouse is in this category? Verify the logic!
+            if ( visibleTile || revealMines ) {
+                fillColor = GetPaletteIndexFromColor( world.ColorCapturedObject( tile.GetIndex() ) );
+            }
+            break;
+        case MP2::OBJ_NON_ACTION_LIGHTHOUSE:
+        case MP2::OBJ_NON_ACTION_ALCHEMIST_LAB:
+        case MP2::OBJ_NON_ACTION_MINE:
+        case MP2::OBJ_NON_ACTION_SAWMILL:
+            // TODO: Why Lighthouse is in this category? Verify the logic!
+            if ( visibleTile || revealMines ) {
+                const int32_t mainTileIndex = Maps::Tile::getIndexOfMainTile( tile );
+                if ( mainTileIndex >= 0 ) {
+                    fillColor = GetPaletteIndexFromColor( world.ColorCapturedObject( mainTileIndex ) );
                 }
-                continue;
-            case MP2::OBJ_NON_ACTION_LIGHTHOUSE:
-            case MP2::OBJ_NON_ACTION_ALCHEMIST_LAB:
-            case MP2::OBJ_NON_ACTION_MINE:
-            case MP2::OBJ_NON_ACTION_SAWMILL:
-                // TODO: Why Lighthouse is in this category? Verify the logic!
-                if ( visibleTile || revealMines ) {
-                    const int32_t mainTileIndex = Maps::Tile::getIndexOfMainTile( tile );
-                    if ( mainTileIndex >= 0 ) {
-                        fillColor = GetPaletteIndexFromColor( world.ColorCapturedObject( mainTileIndex ) );
-                        break;
+            }
+            break;
+        case MP2::OBJ_ARTIFACT:
+            if ( visibleTile || revealArtifacts ) {
+                fillColor = COLOR_GRAY;
+            }
+            break;
+        case MP2::OBJ_RESOURCE:
+            if ( visibleTile || revealResources ) {
+                fillColor = COLOR_GRAY;
+            }
+            break;
+        default:
+            if ( visibleTile ) {
+                // Castles and Towns can be partially covered by other non-action objects so we need to rely on special storage of castle's tiles.
+                if ( !getCastleColor( fillColor, { x, y } ) ) {
+                    // This is a visible tile and not covered by other objects, so fill it with the ground tile data.
+                    if ( tile.isRoad() ) {
+                        fillColor = COLOR_ROAD;
                     }
-                }
-                continue;
-            case MP2::OBJ_ARTIFACT:
-                if ( visibleTile || revealArtifacts ) {
-                    fillColor = COLOR_GRAY;
-                    break;
-                }
-                continue;
-            case MP2::OBJ_RESOURCE:
-                if ( visibleTile || revealResources ) {
-                    fillColor = COLOR_GRAY;
-                    break;
-                }
-                continue;
-            default:
-                if ( visibleTile ) {
-                    // Castles and Towns can be partially covered by other non-action objects so we need to rely on special storage of castle's tiles.
-                    if ( !getCastleColor( fillColor, { x, y } ) ) {
-                        // This is a visible tile and not covered by other objects, so fill it with the ground tile data.
-                        if ( tile.isRoad() ) {
-                            fillColor = COLOR_ROAD;
-                        }
-                        else {
-                            fillColor = GetPaletteIndexFromGround( tile.GetGround() );
+                    else {
+                        fillColor = GetPaletteIndexFromGround( tile.GetGround() );
 
-                            if ( objectType == MP2::OBJ_MOUNTAINS || objectType == MP2::OBJ_TREES ) {
-                                fillColor += 3;
-                            }
+                        if ( objectType == MP2::OBJ_MOUNTAINS || objectType == MP2::OBJ_TREES ) {
+                            fillColor += 3;
                         }
                     }
                 }
-                else if ( revealTowns ) {
-                    getCastleColor( fillColor, { x, y } );
-                }
-                else {
-                    // Non visible tile, we have already black radar so skip the render of this tile.
-                    continue;
-                }
             }
+            else if ( revealTowns ) {
+                getCastleColor( fillColor, { x, y } );
+            }
+            // Non visible tiles are black.
+            break;
+        }
 
-            const size_t offsetX = static_cast<size_t>( x * _zoom );
-            uint8_t * radarX = radarY + offsetX;
-            if ( isZoomIn ) {
-                const uint8_t * radarXEnd = radarYEnd + offsetX;
-                const size_t radarXStep = static_cast<size_t>( ( x + 1 ) * _zoom ) - offsetX;
+        uint8_t & tileColor = _tileColors[static_cast<size_t>( y ) * worldWidth + x];
+        if ( tileColor == fillColor ) {
+            // The tile is already rendered with this color.
+            return;
+        }
 
-                for ( ; radarX != radarXEnd; radarX += radarWidth ) {
-                    std::memset( radarX, fillColor, radarXStep );
-                }
+        tileColor = fillColor;
+        ++repaintedTileCount;
+
+        uint8_t * radarY = radarImage + static_cast<size_t>( y * _zoom ) * radarWidth;
+        const size_t offsetX = static_cast<size_t>( x * _zoom );
+        uint8_t * radarX = radarY + offsetX;
+        if ( isZoomIn ) {
+            const uint8_t * radarXEnd = radarImage + static_cast<size_t>( ( y + 1 ) * _zoom ) * radarWidth + offsetX;
+            const size_t radarXStep = static_cast<size_t>( ( x + 1 ) * _zoom ) - offsetX;
+
+            for ( ; radarX != radarXEnd; radarX += radarWidth ) {
+                std::memset( radarX, fillColor, radarXStep );
             }
-            else {
-                *radarX = fillColor;
+        }
+        else {
+            *radarX = fillColor;
+        }
+    };
+
+    [[maybe_unused]] size_t evaluatedTileCount = 0;
+
+    if ( redrawAllTiles ) {
+        for ( int32_t y = 0; y < worldHeight; ++y ) {
+            for ( int32_t x = 0; x < worldWidth; ++x ) {
+                redrawTile( x, y );
             }
         }
+
+        evaluatedTileCount = tileCount;
+    }
+    else {
+        for ( const int32_t tileIndex : changedTiles ) {
+            redrawTile( tileIndex % worldWidth, tileIndex / worldWidth );
+        }
+
+        evaluatedTileCount = changedTiles.size();
     }
 
-    // Reset ROI to full radar image to be able to redraw the mini-map without calling 'SetMapRedraw()'.
-    _roi = { 0, 0, world.w(), world.h() };
+    DEBUG_LOG( DBG_GAME, DBG_INFO, "Radar tiles evaluated: " << evaluatedTileCount << " of " << tileCount << ", repainted: " << repaintedTileCount )
 }
 
 // Redraw radar cursor. RoiRectangle is a rectangle in tile unit of the current radar view.
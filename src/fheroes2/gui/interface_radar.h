@@ -24,6 +24,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 #include "color.h"
 #include "image.h"
@@ -57,11 +58,12 @@ namespace Interface
         void SetPos( int32_t x, int32_t y ) override;
 
         // Set the render redraw flag from Interface::Redraw enumeration:
-        // - 'REDRAW_RADAR' - to redraw the radar map image fully or in ROI and render the cursor over it.
+        // - 'REDRAW_RADAR' - to redraw the changed tiles of the radar map image and render the cursor over it.
         // - 'REDRAW_RADAR_CURSOR' - to render the previously generated radar map image and the cursor over it.
         void SetRedraw( const uint32_t redrawMode ) const;
 
-        // Set the "need" of render the radar map only in the given 'roi' on next radar Redraw call.
+        // Marks the tiles in the given 'roi' as changed so they are rendered again on the next radar map redraw. Most changes of the world
+        // are tracked by the world itself, this method is needed only for changes unknown to it.
         void SetRenderArea( const fheroes2::Rect & roi );
         void Build();
         void RedrawForViewWorld( const ViewWorld::ZoomROIs & roi, ViewWorldMode mode, const bool renderMapObjects );
@@ -96,8 +98,14 @@ namespace Interface
         BaseInterface & _interface;
 
         fheroes2::Image _map;
+
+        // Colors of all world map tiles currently rendered on the radar map image. Once the image is rendered, only the tiles marked
+        // as changed by the world are evaluated and rendered again.
+        std::vector<uint8_t> _tileColors;
+        PlayerColorsSet _tileColorsPlayerColor{ 0 };
+        ViewWorldMode _tileColorsMode{ ViewWorldMode::OnlyVisible };
+
         fheroes2::MovableSprite _cursorArea;
-        fheroes2::Rect _roi;
         double _zoom{ 1.0 };
         bool _hide{ true };
     };
@@ -24,12 +24,18 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdlib>
+#include <functional>
 #include <map>
 #include <memory>
 #include <numeric>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
 
 #include "agg_image.h"
 #include "icn.h"
+#include "logging.h"
 #include "ui_language.h"
 
 namespace
@@ -323,6 +329,116 @@ namespace
 
         return std::make_unique<fheroes2::LanguageSwitcher>( language.value() );
     }
+
+    // The keys stored in the cache own their texts while the keys used for lookups only refer to the texts, so the texts are not copied
+    // on every lookup.
+    template <typename StringType>
+    struct TextLayoutKey
+    {
+        StringType text;
+        fheroes2::FontSize fontSize{ fheroes2::FontSize::NORMAL };
+        fheroes2::FontColor fontColor{ fheroes2::FontColor::WHITE };
+        fheroes2::SupportedLanguage language{ fheroes2::SupportedLanguage::English };
+        int32_t maxWidth{ 0 };
+        int32_t rowHeight{ 0 };
+        bool keepLineTrailingSpaces{ false };
+        bool keepTextTrailingSpaces{ false };
+
+        auto tie() const
+        {
+            return std::tie( maxWidth, rowHeight, fontSize, fontColor, language, keepLineTrailingSpaces, keepTextTrailingSpaces, text );
+        }
+    };
+
+    template <typename FirstStringType, typename SecondStringType>
+    bool operator<( const TextLayoutKey<FirstStringType> & first, const TextLayoutKey<SecondStringType> & second )
+    {
+        return first.tie() < second.tie();
+    }
+
+    using StoredTextLayoutKey = TextLayoutKey<std::string>;
+    using TextLayoutKeyView = TextLayoutKey<std::string_view>;
+
+    // The same texts are laid out again and again, for example on every frame of a dialog or by every call of width() and height() of the same
+    // text, while it requires to measure every character of the text. This cache keeps the layouts of the recently used texts.
+    class TextLayoutCache
+    {
+    public:
+        // Returns nullptr if there is no layout for the given key in the cache. The returned layout stays valid until the next call of add().
+        const std::vector<fheroes2::TextLineInfo> * get( const TextLayoutKeyView & key )
+        {
+            const auto iter = _layouts.find( key );
+            if ( iter == _layouts.end() ) {
+                ++_missCount;
+                return nullptr;
+            }
+
+            ++_hitCount;
+
+            iter->second.lastUse = ++_useCounter;
+
+            return &iter->second.lineInfos;
+        }
+
+        const std::vector<fheroes2::TextLineInfo> & add( const TextLayoutKeyView & key, std::vector<fheroes2::TextLineInfo> lineInfos )
+        {
+            if ( _layouts.size() >= maxLayoutCount ) {
+                _removeLeastRecentlyUsed();
+            }
+
+            StoredTextLayoutKey storedKey{ std::string( key.text ), key.fontSize, key.fontColor, key.language, key.maxWidth, key.rowHeight,
+                                           key.keepLineTrailingSpaces, key.keepTextTrailingSpaces };
+
+            Layout & layout = _layouts[std::move( storedKey )];
+            layout = { std::move( lineInfos ), ++_useCounter };
+
+            return layout.lineInfos;
+        }
+
+    private:
+        // Maximum number of layouts kept in the cache. When it is reached, the least recently used half of the layouts is removed.
+        static const size_t maxLayoutCount{ 1024 };
+
+        struct Layout
+        {
+            std::vector<fheroes2::TextLineInfo> lineInfos;
+            uint64_t lastUse{ 0 };
+        };
+
+        std::map<StoredTextLayoutKey, Layout, std::less<>> _layouts;
+
+        uint64_t _useCounter{ 0 };
+        uint64_t _hitCount{ 0 };
+        uint64_t _missCount{ 0 };
+
+        void _removeLeastRecentlyUsed()
+        {
+            std::vector<uint64_t> lastUses;
+            lastUses.reserve( _layouts.size() );
+
+            for ( const auto & [key, layout] : _layouts ) {
+                lastUses.push_back( layout.lastUse );
+            }
+
+            auto medianIter = lastUses.begin() + static_cast<ptrdiff_t>( lastUses.size() / 2 );
+            std::nth_element( lastUses.begin(), medianIter, lastUses.end() );
+
+            const uint64_t minLastUseToKeep = *medianIter;
+
+            for ( auto iter = _layouts.begin(); iter != _layouts.end(); ) {
+                if ( iter->second.lastUse < minLastUseToKeep ) {
+                    iter = _layouts.erase( iter );
+                }
+                else {
+                    ++iter;
+                }
+            }
+
+            DEBUG_LOG( DBG_GAME, DBG_TRACE, "Text layout cache: " << _hitCount << " hits, " << _missCount << " misses, " << _layouts.size() << " layouts kept." )
+        }
+    };
+
+    TextLayoutCache textLayoutCache;
 }
 
 namespace fheroes2
@@ -376,8 +492,7 @@ namespace fheroes2
         const auto languageSwitcher = getLanguageSwitcher( *this );
         const int32_t fontHeight = height();
 
-        std::vector<TextLineInfo> lineInfos;
-        _getTextLineInfos( lineInfos, maxWidth, fontHeight, false );
+        const std::vector<TextLineInfo> & lineInfos = _getTextLineInfos( maxWidth, fontHeight, false );
 
         if ( lineInfos.size() == 1 ) {
             // This is a single-line message.
@@ -396,8 +511,10 @@ namespace fheroes2
 
         while ( startWidth + 1 < endWidth ) {
             const int32_t currentWidth = ( endWidth + startWidth ) / 2;
+
+            // The layouts for intermediate widths are needed only once so they are not put into the cache.
             std::vector<TextLineInfo> tempLineInfos;
-            _getTextLineInfos( tempLineInfos, currentWidth, fontHeight, false );
+            _calculateTextLineInfos( tempLineInfos, currentWidth, fontHeight, false );
 
             if ( tempLineInfos.size() > lineInfos.size() ) {
                 startWidth = currentWidth;
@@ -419,8 +536,7 @@ namespace fheroes2
         const auto languageSwitcher = getLanguageSwitcher( *this );
         const int32_t fontHeight = height();
 
-        std::vector<TextLineInfo> lineInfos;
-        _getTextLineInfos( lineInfos, maxWidth, fontHeight, false );
+        const std::vector<TextLineInfo> & lineInfos = _getTextLineInfos( maxWidth, fontHeight, false );
 
         return lineInfos.back().offsetY + fontHeight;
     }
@@ -432,8 +548,7 @@ namespace fheroes2
         }
 
         const auto languageSwitcher = getLanguageSwitcher( *this );
-        std::vector<TextLineInfo> lineInfos;
-        _getTextLineInfos( lineInfos, maxWidth, height(), false );
+        const std::vector<TextLineInfo> & lineInfos = _getTextLineInfos( maxWidth, height(), false );
 
         return static_cast<int32_t>( lineInfos.size() );
     }
@@ -477,8 +592,7 @@ namespace fheroes2
 
         const auto languageSwitcher = getLanguageSwitcher( *this );
 
-        std::vector<TextLineInfo> lineInfos;
-        _getTextLineInfos( lineInfos, maxWidth, height(), false );
+        const std::vector<TextLineInfo> & lineInfos = _getTextLineInfos( maxWidth, height(), false );
 
         const uint8_t * data = reinterpret_cast<const uint8_t *>( _text.data() );
         const FontCharHandler charHandler( _fontType );
@@ -563,7 +677,23 @@ namespace fheroes2
         }
     }
 
-    void Text::_getTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight, const bool keepTextTrailingSpaces ) const
+    const std::vector<TextLineInfo> & Text::_getTextLineInfos( const int32_t maxWidth, const int32_t rowHeight, const bool keepTextTrailingSpaces ) const
+    {
+        const TextLayoutKeyView key{ _text, _fontType.size, _fontType.color, getCurrentLanguage(), maxWidth, rowHeight, _keepLineTrailingSpaces, keepTextTrailingSpaces };
+
+        const std::vector<TextLineInfo> * cachedLineInfos = textLayoutCache.get( key );
+        if ( cachedLineInfos != nullptr ) {
+            return *cachedLineInfos;
+        }
+
+        std::vector<TextLineInfo> textLineInfos;
+        _calculateTextLineInfos( textLineInfos, maxWidth, rowHeight, keepTextTrailingSpaces );
+
+        return textLayoutCache.add( key, std::move( textLineInfos ) );
+    }
+
+    void Text::_calculateTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight,
+                                        const bool keepTextTrailingSpaces ) const
     {
         assert( !_text.empty() );
 
@@ -765,8 +895,7 @@ namespace fheroes2
 
     size_t TextInput::getCursorPositionInAdjacentLine( const size_t currentPos, const int32_t maxWidth, const bool moveUp )
     {
-        std::vector<TextLineInfo> tempLineInfos;
-        _getTextLineInfos( tempLineInfos, maxWidth, height(), true );
+        const std::vector<TextLineInfo> & tempLineInfos = _getTextLineInfos( maxWidth, height(), true );
         if ( tempLineInfos.empty() ) {
             return currentPos;
         }
@@ -943,8 +1072,7 @@ namespace fheroes2
             return 0;
         }
 
-        std::vector<TextLineInfo> lineInfos;
-        _getTextLineInfos( lineInfos, _maxTextWidth, fontHeight, true );
+        const std::vector<TextLineInfo> & lineInfos = _getTextLineInfos( _maxTextWidth, fontHeight, true );
 
         if ( pointerLine >= static_cast<int32_t>( lineInfos.size() ) ) {
             // Pointer is lower than the last text line.
@@ -1051,8 +1179,7 @@ namespace fheroes2
             // This is a multi-line text.
 
             const int32_t textHeight = height();
-            std::vector<TextLineInfo> lineInfos;
-            _getTextLineInfos( lineInfos, _maxTextWidth, textHeight, true );
+            const std::vector<TextLineInfo> & lineInfos = _getTextLineInfos( _maxTextWidth, textHeight, true );
 
             if ( _cursorPositionInText == static_cast<int32_t>( _text.size() ) ) {
                 // The cursor is at the end of the text.
@@ -1326,7 +1453,13 @@ namespace fheroes2
             // To properly render a multi-font text we must not ignore spaces at the end of a text entry which is not the last one.
             const bool isNotLastTextEntry = ( i != textsCount - 1 );
 
-            _texts[i]._getTextLineInfos( textLineInfos, maxWidth, rowHeight, isNotLastTextEntry );
+            if ( textLineInfos.empty() ) {
+                textLineInfos = _texts[i]._getTextLineInfos( maxWidth, rowHeight, isNotLastTextEntry );
+            }
+            else {
+                // The layout of this text depends on the previous texts so it is not cached.
+                _texts[i]._calculateTextLineInfos( textLineInfos, maxWidth, rowHeight, isNotLastTextEntry );
+            }
         }
     }
 
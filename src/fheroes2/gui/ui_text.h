@@ -266,7 +266,12 @@ namespace fheroes2
         // Returns text lines parameters (in pixels) in 'offsets': x - horizontal line shift, y - vertical line shift.
         // And in 'characterCount' - the number of characters on the line, in 'lineWidth' the width including the `offsetX` value.
         // The 'keepTextTrailingSpaces' is used to take into account all the spaces at the text end in example when you want to join multiple texts in multi-font texts.
-        void _getTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight, const bool keepTextTrailingSpaces ) const;
+        // The returned lines are kept in the cache of text layouts and stay valid until the next call of this method for any text.
+        const std::vector<TextLineInfo> & _getTextLineInfos( const int32_t maxWidth, const int32_t rowHeight, const bool keepTextTrailingSpaces ) const;
+
+        // Does the same as _getTextLineInfos() but without using the cache of text layouts. The lines are appended to the given lines of the previous texts.
+        void _calculateTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight,
+                                      const bool keepTextTrailingSpaces ) const;
 
         std::string _text;
 
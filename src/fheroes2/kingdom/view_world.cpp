@@ -23,10 +23,18 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "castle.h"
@@ -42,6 +50,7 @@
 #include "interface_gamearea.h"
 #include "interface_radar.h"
 #include "localevent.h"
+#include "maps_fileinfo.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "mp2.h"
@@ -49,6 +58,8 @@
 #include "resource.h"
 #include "screen.h"
 #include "settings.h"
+#include "thread.h"
+#include "tools.h"
 #include "translations.h"
 #include "ui_button.h"
 #include "ui_constants.h"
@@ -186,92 +197,10 @@ namespace
         }
     }
 
-    struct CacheForMapWithResources
-    {
-        std::vector<fheroes2::Image> cachedImages; // One image per zoom Level
-
-        CacheForMapWithResources() = delete;
-
-        // Compute complete world map, and save it for all zoom levels
-        explicit CacheForMapWithResources( const ViewWorldMode viewMode, Interface::GameArea & gameArea, const size_t zoomLevels )
-        {
-            cachedImages.resize( zoomLevels );
-
-            for ( size_t i = 0; i < zoomLevels; ++i ) {
-                cachedImages[i]._disableTransformLayer();
-                cachedImages[i].resize( world.w() * tileSizePerZoomLevel[i], world.h() * tileSizePerZoomLevel[i] );
-            }
-
-            const int32_t blockSizeX = 18;
-            const int32_t blockSizeY = 18;
-
-            const int32_t worldWidth = world.w();
-            const int32_t worldHeight = world.h();
-
-            // Assert will fail in case we add non-standard map sizes, otherwise standard map sizes are multiples of 18 tiles
-            assert( worldWidth % blockSizeX == 0 );
-            assert( worldHeight % blockSizeY == 0 );
-
-            const int32_t redrawAreaWidth = blockSizeX * fheroes2::tileWidthPx;
-            const int32_t redrawAreaHeight = blockSizeY * fheroes2::tileWidthPx;
-            const int32_t redrawAreaCenterX = blockSizeX * fheroes2::tileWidthPx / 2;
-            const int32_t redrawAreaCenterY = blockSizeY * fheroes2::tileWidthPx / 2;
-
-            // Create temporary image where we will draw blocks of the main map on
-            fheroes2::Image temporaryImg;
-            temporaryImg._disableTransformLayer();
-            temporaryImg.resize( redrawAreaWidth, redrawAreaHeight );
-
-            // Remember the original game area ROI and center of the view.
-            const fheroes2::Rect gameAreaRoi( gameArea.GetROI() );
-            const fheroes2::Point gameAreaCenter( gameArea.getCurrentCenterInPixels() );
-
-            gameArea.SetAreaPosition( 0, 0, redrawAreaWidth, redrawAreaHeight );
-            int32_t drawingFlags = Interface::RedrawLevelType::LEVEL_ALL & ~Interface::RedrawLevelType::LEVEL_ROUTES;
-            if ( viewMode == ViewWorldMode::ViewAll ) {
-                drawingFlags &= ~Interface::RedrawLevelType::LEVEL_FOG;
-            }
-            else if ( viewMode == ViewWorldMode::ViewTowns ) {
-                drawingFlags |= Interface::RedrawLevelType::LEVEL_TOWNS;
-            }
-
-#if !defined( SAVE_WORLD_MAP )
-            drawingFlags ^= Interface::RedrawLevelType::LEVEL_HEROES;
-#endif
-
-            // Draw sub-blocks of the main map, and resize them to draw them on lower-res cached versions:
-            for ( int32_t x = 0; x < worldWidth; x += blockSizeX ) {
-                for ( int32_t y = 0; y < worldHeight; y += blockSizeY ) {
-                    gameArea.SetCenterInPixels( { x * fheroes2::tileWidthPx + redrawAreaCenterX, y * fheroes2::tileWidthPx + redrawAreaCenterY } );
-                    gameArea.Redraw( temporaryImg, drawingFlags );
-
-                    for ( size_t i = 0; i < zoomLevels; ++i ) {
-                        fheroes2::Resize( temporaryImg, 0, 0, temporaryImg.width(), temporaryImg.height(), cachedImages[i], x * tileSizePerZoomLevel[i],
-                                          y * tileSizePerZoomLevel[i], blockSizeX * tileSizePerZoomLevel[i], blockSizeY * tileSizePerZoomLevel[i] );
-                    }
-                }
-            }
-
-            // Restore the original game area ROI and center of the view.
-            gameArea.SetAreaPosition( gameAreaRoi.x, gameAreaRoi.y, gameAreaRoi.width, gameAreaRoi.height );
-            gameArea.SetCenterInPixels( gameAreaCenter );
-
-#if defined( SAVE_WORLD_MAP )
-            fheroes2::Save( cachedImages[3], Settings::Get().getCurrentMapInfo().name + saveFilePrefix + ".bmp" );
-#endif
-        }
-
-        size_t getZoomLevels() const
-        {
-            return cachedImages.size();
-        }
-    };
-
-    void DrawWorld( const ViewWorld::ZoomROIs & ROI, CacheForMapWithResources & cache, const fheroes2::Rect & roiScreen )
+    void DrawWorld( const ViewWorld::ZoomROIs & ROI, const fheroes2::Image & image, const fheroes2::Rect & roiScreen )
     {
         fheroes2::Display & display = fheroes2::Display::instance();
         const uint8_t zoomLevelId = static_cast<uint8_t>( ROI.getZoomLevel() );
-        const fheroes2::Image & image = cache.cachedImages[zoomLevelId];
 
         const int32_t offsetPixelsX = tileSizePerZoomLevel[zoomLevelId] * ROI.GetROIinPixels().x / fheroes2::tileWidthPx;
         const int32_t offsetPixelsY = tileSizePerZoomLevel[zoomLevelId] * ROI.GetROIinPixels().y / fheroes2::tileWidthPx;
@@ -314,7 +243,7 @@ namespace
         }
     }
 
-    void DrawObjectsIcons( const PlayerColor color, const ViewWorldMode mode, CacheForMapWithResources & cache )
+    void DrawObjectsIcons( const PlayerColor color, const ViewWorldMode mode, fheroes2::Image & image, const size_t zoomLevelId )
     {
         const bool revealAll = mode == ViewWorldMode::ViewAll;
         const bool revealMines = revealAll || ( mode == ViewWorldMode::ViewMines );
@@ -327,38 +256,33 @@ namespace
         const int32_t worldHeight = world.h();
         assert( worldWidth >= 0 && worldHeight >= 0 );
 
-        // Render two flags to the left and to the right of Castle/Town entrance.
-        const auto renderCastleFlags = [&cache]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
-            for ( size_t zoomLevelId = 0; zoomLevelId < cache.getZoomLevels(); ++zoomLevelId ) {
-                const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
+        const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
 
-                const int32_t icnFlagsBase = icnPerZoomLevelFlags[zoomLevelId];
-                const uint32_t flagIndex = ( icnFlagsBase == ICN::FLAG32 ) ? ( 2 * icnIndex + 1 ) : icnIndex;
-                const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnFlagsBase, flagIndex );
+        // Render two flags to the left and to the right of Castle/Town entrance.
+        const auto renderCastleFlags = [&image, zoomLevelId, tileSize]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
+            const int32_t icnFlagsBase = icnPerZoomLevelFlags[zoomLevelId];
+            const uint32_t flagIndex = ( icnFlagsBase == ICN::FLAG32 ) ? ( 2 * icnIndex + 1 ) : icnIndex;
+            const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnFlagsBase, flagIndex );
 
-                const int32_t dstx = posX * tileSize + ( tileSize - sprite.width() ) / 2;
-                const int32_t dsty = posY * tileSize + ( tileSize - sprite.height() ) / 2 + 1;
+            const int32_t dstx = posX * tileSize + ( tileSize - sprite.width() ) / 2;
+            const int32_t dsty = posY * tileSize + ( tileSize - sprite.height() ) / 2 + 1;
 
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx + tileSize, dsty, false );
-                // We place a second flag, flipped horizontally.
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx - tileSize, dsty, true );
-            }
+            fheroes2::Blit( sprite, image, dstx + tileSize, dsty, false );
+            // We place a second flag, flipped horizontally.
+            fheroes2::Blit( sprite, image, dstx - tileSize, dsty, true );
         };
 
         // Render hero/artifact icon.
-        const auto renderIcon = [&cache]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
-            for ( size_t zoomLevelId = 0; zoomLevelId < cache.getZoomLevels(); ++zoomLevelId ) {
-                const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
-                const int32_t dstx = posX * tileSize + tileSize / 2;
-                const int32_t dsty = posY * tileSize + tileSize / 2;
-
-                const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnPerZoomLevel[zoomLevelId], icnIndex );
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
-            }
+        const auto renderIcon = [&image, zoomLevelId, tileSize]( const uint32_t icnIndex, const int32_t posX, const int32_t posY ) {
+            const int32_t dstx = posX * tileSize + tileSize / 2;
+            const int32_t dsty = posY * tileSize + tileSize / 2;
+
+            const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnPerZoomLevel[zoomLevelId], icnIndex );
+            fheroes2::Blit( sprite, image, dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
         };
 
         // Render resource/mine icon with letter inside.
-        const auto renderResourceIcon = [&cache]( const uint32_t icnIndex, const uint32_t resource, const int32_t posX, const int32_t posY ) {
+        const auto renderResourceIcon = [&image, zoomLevelId, tileSize]( const uint32_t icnIndex, const uint32_t resource, const int32_t posX, const int32_t posY ) {
             const uint32_t letterIndex = resourceToOffsetICN( resource );
 
             if ( letterIndex == unknownIndex ) {
@@ -366,16 +290,13 @@ namespace
                 return;
             }
 
-            for ( size_t zoomLevelId = 0; zoomLevelId < cache.getZoomLevels(); ++zoomLevelId ) {
-                const int32_t tileSize = tileSizePerZoomLevel[zoomLevelId];
-                const int32_t dstx = posX * tileSize + tileSize / 2;
-                const int32_t dsty = posY * tileSize + tileSize / 2;
+            const int32_t dstx = posX * tileSize + tileSize / 2;
+            const int32_t dsty = posY * tileSize + tileSize / 2;
 
-                const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnPerZoomLevel[zoomLevelId], icnIndex );
-                fheroes2::Blit( sprite, cache.cachedImages[zoomLevelId], dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
-                const fheroes2::Sprite & letter = fheroes2::AGG::GetICN( icnLetterPerZoomLevel[zoomLevelId], letterIndex );
-                fheroes2::Blit( letter, cache.cachedImages[zoomLevelId], dstx - letter.width() / 2, dsty - letter.height() / 2 );
-            }
+            const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icnPerZoomLevel[zoomLevelId], icnIndex );
+            fheroes2::Blit( sprite, image, dstx - sprite.width() / 2, dsty - sprite.height() / 2 );
+            const fheroes2::Sprite & letter = fheroes2::AGG::GetICN( icnLetterPerZoomLevel[zoomLevelId], letterIndex );
+            fheroes2::Blit( letter, image, dstx - letter.width() / 2, dsty - letter.height() / 2 );
         };
 
         // There could be maximum 2 objects on the tile to analyze (in example: a Hero and a Castle).
@@ -459,6 +380,422 @@ namespace
         }
     }
 
+    // Calculates a hash of the state of all tiles which affects the rendering of the world map. It is used to detect changes of the world
+    // between openings of the View World window since there are too many places where the world can be modified to track them all.
+    uint64_t getWorldMapHash()
+    {
+        fheroes2::FNV1aHash hash;
+
+        const int32_t worldWidth = world.w();
+        const int32_t worldHeight = world.h();
+
+        hash.update( static_cast<uint32_t>( worldWidth ) );
+        hash.update( static_cast<uint32_t>( worldHeight ) );
+
+        const auto updatePartHash = [&hash]( const Maps::ObjectPart & part ) {
+            hash.update( ( static_cast<uint32_t>( part.icnType ) << 16 ) | ( static_cast<uint32_t>( part.icnIndex ) << 8 ) | part.layerType );
+        };
+
+        for ( int32_t y = 0; y < worldHeight; ++y ) {
+            for ( int32_t x = 0; x < worldWidth; ++x ) {
+                const Maps::Tile & tile = world.getTile( x, y );
+
+                hash.update( ( static_cast<uint32_t>( tile.getTerrainImageIndex() ) << 8 ) | tile.getTerrainFlags() );
+                // Heroes are not rendered on the world map.
+                hash.update( ( static_cast<uint32_t>( tile.getMainObjectType( false ) ) << 16 ) | tile.getFogDirection() );
+
+                for ( const uint32_t value : tile.metadata() ) {
+                    hash.update( value );
+                }
+
+                updatePartHash( tile.getMainObjectPart() );
+
+                for ( const auto & part : tile.getGroundObjectParts() ) {
+                    updatePartHash( part );
+                }
+
+                // Separate ground object parts from top object parts.
+                hash.update( static_cast<uint32_t>( tile.getGroundObjectParts().size() ) );
+
+                for ( const auto & part : tile.getTopObjectParts() ) {
+                    updatePartHash( part );
+                }
+
+                hash.update( static_cast<uint32_t>( tile.getTopObjectParts().size() ) );
+            }
+        }
+
+        return hash.value();
+    }
+
+    // The world map rendered for all zoom levels without any object icons.
+    struct WorldMapImages
+    {
+        // Hash of the world map state the images were rendered for.
+        uint64_t worldHash{ 0 };
+
+        // The value of the access counter at the last time these images were used.
+        uint32_t lastAccess{ 0 };
+
+        std::vector<fheroes2::Image> images; // One image per zoom Level
+    };
+
+    // Rendering of the whole world map takes a lot of time on big maps, so the rendered images are kept between openings of the View World
+    // window. The images are different for different drawing flags of the game area.
+    struct WorldMapCache
+    {
+        // Identity of the map the images were rendered for. A new game on the same map gets a new seed.
+        std::string mapFileName;
+        uint32_t mapSeed{ 0 };
+
+        uint32_t accessCounter{ 0 };
+
+        std::map<int32_t, WorldMapImages> imagesPerDrawingFlags;
+    };
+
+    WorldMapCache worldMapCache;
+
+    // A few drawing flag sets are used by the View World window but usually only one or two of them are used during a game.
+    const size_t maxCachedDrawingFlagSets = 2;
+
+    size_t getMemorySize( const WorldMapImages & worldMap )
+    {
+        size_t size = 0;
+
+        for ( const fheroes2::Image & image : worldMap.images ) {
+            size += static_cast<size_t>( image.width() ) * image.height() * ( image.singleLayer() ? 1 : 2 );
+        }
+
+        return size;
+    }
+
+    size_t getWorldMapCacheMemorySize()
+    {
+        size_t size = 0;
+
+        for ( const auto & [drawingFlags, worldMap] : worldMapCache.imagesPerDrawingFlags ) {
+            size += getMemorySize( worldMap );
+        }
+
+        return size;
+    }
+
+    void removeLeastRecentlyUsedWorldMap( const std::optional<int32_t> drawingFlagsToKeep )
+    {
+        auto & imagesPerDrawingFlags = worldMapCache.imagesPerDrawingFlags;
+
+        auto leastRecentlyUsed = imagesPerDrawingFlags.end();
+        for ( auto iter = imagesPerDrawingFlags.begin(); iter != imagesPerDrawingFlags.end(); ++iter ) {
+            if ( drawingFlagsToKeep == iter->first ) {
+                continue;
+            }
+
+            if ( leastRecentlyUsed == imagesPerDrawingFlags.end() || iter->second.lastAccess < leastRecentlyUsed->second.lastAccess ) {
+                leastRecentlyUsed = iter;
+            }
+        }
+
+        if ( leastRecentlyUsed != imagesPerDrawingFlags.end() ) {
+            imagesPerDrawingFlags.erase( leastRecentlyUsed );
+        }
+    }
+
+    // Removes all cached images if they were rendered for another map or another game.
+    void validateWorldMapCacheIdentity()
+    {
+        const std::string & mapFileName = Settings::Get().getCurrentMapInfo().filename;
+        const uint32_t mapSeed = world.GetMapSeed();
+
+        if ( worldMapCache.mapFileName == mapFileName && worldMapCache.mapSeed == mapSeed ) {
+            return;
+        }
+
+        worldMapCache.imagesPerDrawingFlags.clear();
+        worldMapCache.mapFileName = mapFileName;
+        worldMapCache.mapSeed = mapSeed;
+    }
+
+    WorldMapImages & getCachedWorldMap( const int32_t drawingFlags )
+    {
+        validateWorldMapCacheIdentity();
+
+        auto & imagesPerDrawingFlags = worldMapCache.imagesPerDrawingFlags;
+
+        if ( imagesPerDrawingFlags.count( drawingFlags ) == 0 ) {
+            while ( imagesPerDrawingFlags.size() >= maxCachedDrawingFlagSets ) {
+                removeLeastRecentlyUsedWorldMap( drawingFlags );
+            }
+        }
+
+        WorldMapImages & worldMap = imagesPerDrawingFlags[drawingFlags];
+        worldMap.lastAccess = ++worldMapCache.accessCounter;
+
+        return worldMap;
+    }
+
+    // Resizes the rendered blocks of the world map to the zoom levels which are not shown right away.
+    class ZoomLevelBuilder final : public MultiThreading::AsyncManager
+    {
+    public:
+        ZoomLevelBuilder( std::vector<fheroes2::Image> & images, const size_t skippedZoomLevelId )
+            : _images( images )
+            , _skippedZoomLevelId( skippedZoomLevelId )
+        {
+            // Do nothing.
+        }
+
+        ZoomLevelBuilder( const ZoomLevelBuilder & ) = delete;
+
+        ~ZoomLevelBuilder() override = default;
+
+        ZoomLevelBuilder & operator=( const ZoomLevelBuilder & ) = delete;
+
+        // Adds the rendered block of the world map which starts at the given tile. The images of all zoom levels except the skipped one
+        // must not be accessed until wait() is called.
+        void push( fheroes2::Image block, const fheroes2::Point & tilePosition )
+        {
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _tasks.push_back( { std::move( block ), tilePosition } );
+
+            notifyWorker();
+        }
+
+        // Waits for all the added blocks to be resized.
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            _taskCompletion.wait( lock, [this] { return _tasks.empty() && !_currentTask; } );
+        }
+
+    private:
+        struct Task
+        {
+            fheroes2::Image block;
+            fheroes2::Point tilePosition;
+        };
+
+        std::vector<fheroes2::Image> & _images;
+        const size_t _skippedZoomLevelId;
+
+        std::deque<Task> _tasks;
+        std::optional<Task> _currentTask;
+
+        std::condition_variable _taskCompletion;
+
+        bool prepareTask() override
+        {
+            assert( !_tasks.empty() );
+
+            _currentTask = std::move( _tasks.front() );
+            _tasks.pop_front();
+
+            return !_tasks.empty();
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            // The _currentTask is modified only by the worker thread, so it is safe to read it without locking.
+            assert( _currentTask );
+
+            const fheroes2::Image & block = _currentTask->block;
+            const fheroes2::Point & tilePosition = _currentTask->tilePosition;
+            const int32_t blockWidth = block.width() / fheroes2::tileWidthPx;
+            const int32_t blockHeight = block.height() / fheroes2::tileWidthPx;
+
+            for ( size_t i = 0; i < _images.size(); ++i ) {
+                if ( i == _skippedZoomLevelId ) {
+                    continue;
+                }
+
+                fheroes2::Resize( block, 0, 0, block.width(), block.height(), _images[i], tilePosition.x * tileSizePerZoomLevel[i],
+                                  tilePosition.y * tileSizePerZoomLevel[i], blockWidth * tileSizePerZoomLevel[i], blockHeight * tileSizePerZoomLevel[i] );
+            }
+
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _currentTask.reset();
+            }
+
+            _taskCompletion.notify_all();
+        }
+    };
+
+    // Renders the whole world map. Only the image of the given zoom level is ready upon return, other zoom levels are built by the given builder.
+    void renderWorldMap( std::vector<fheroes2::Image> & images, const int32_t drawingFlags, Interface::GameArea & gameArea, const size_t currentZoomLevelId,
+                         ZoomLevelBuilder & builder )
+    {
+        for ( size_t i = 0; i < images.size(); ++i ) {
+            images[i]._disableTransformLayer();
+            images[i].resize( world.w() * tileSizePerZoomLevel[i], world.h() * tileSizePerZoomLevel[i] );
+        }
+
+        const int32_t blockSizeX = 18;
+        const int32_t blockSizeY = 18;
+
+        const int32_t worldWidth = world.w();
+        const int32_t worldHeight = world.h();
+
+        // Assert will fail in case we add non-standard map sizes, otherwise standard map sizes are multiples of 18 tiles
+        assert( worldWidth % blockSizeX == 0 );
+        assert( worldHeight % blockSizeY == 0 );
+
+        const int32_t redrawAreaWidth = blockSizeX * fheroes2::tileWidthPx;
+        const int32_t redrawAreaHeight = blockSizeY * fheroes2::tileWidthPx;
+        const int32_t redrawAreaCenterX = blockSizeX * fheroes2::tileWidthPx / 2;
+        const int32_t redrawAreaCenterY = blockSizeY * fheroes2::tileWidthPx / 2;
+
+        // Create temporary image where we will draw blocks of the main map on
+        fheroes2::Image temporaryImg;
+        temporaryImg._disableTransformLayer();
+        temporaryImg.resize( redrawAreaWidth, redrawAreaHeight );
+
+        // Remember the original game area ROI and center of the view.
+        const fheroes2::Rect gameAreaRoi( gameArea.GetROI() );
+        const fheroes2::Point gameAreaCenter( gameArea.getCurrentCenterInPixels() );
+
+        gameArea.SetAreaPosition( 0, 0, redrawAreaWidth, redrawAreaHeight );
+
+        fheroes2::Image & currentImage = images[currentZoomLevelId];
+        const int32_t currentTileSize = tileSizePerZoomLevel[currentZoomLevelId];
+
+        // Draw sub-blocks of the main map, and resize them to draw them on lower-res cached versions:
+        for ( int32_t x = 0; x < worldWidth; x += blockSizeX ) {
+            for ( int32_t y = 0; y < worldHeight; y += blockSizeY ) {
+                gameArea.SetCenterInPixels( { x * fheroes2::tileWidthPx + redrawAreaCenterX, y * fheroes2::tileWidthPx + redrawAreaCenterY } );
+                gameArea.Redraw( temporaryImg, drawingFlags );
+
+                fheroes2::Resize( temporaryImg, 0, 0, temporaryImg.width(), temporaryImg.height(), currentImage, x * currentTileSize, y * currentTileSize,
+                                  blockSizeX * currentTileSize, blockSizeY * currentTileSize );
+
+                if ( images.size() > 1 ) {
+                    builder.push( temporaryImg, { x, y } );
+                }
+            }
+        }
+
+        // Restore the original game area ROI and center of the view.
+        gameArea.SetAreaPosition( gameAreaRoi.x, gameAreaRoi.y, gameAreaRoi.width, gameAreaRoi.height );
+        gameArea.SetCenterInPixels( gameAreaCenter );
+    }
+
+    class CacheForMapWithResources
+    {
+    public:
+        CacheForMapWithResources() = delete;
+
+        // Prepares the world map for the given zoom level right away. Other zoom levels are prepared in the background if they are not
+        // available from the previous openings of the View World window.
+        CacheForMapWithResources( const PlayerColor color, const ViewWorldMode viewMode, const bool renderIcons, Interface::GameArea & gameArea,
+                                  const size_t zoomLevels, const ZoomLevel currentZoomLevel )
+            : _color( color )
+            , _viewMode( viewMode )
+            , _renderIcons( renderIcons )
+            , _cachedImages( zoomLevels )
+        {
+            int32_t drawingFlags = Interface::RedrawLevelType::LEVEL_ALL & ~Interface::RedrawLevelType::LEVEL_ROUTES;
+            if ( viewMode == ViewWorldMode::ViewAll ) {
+                drawingFlags &= ~Interface::RedrawLevelType::LEVEL_FOG;
+            }
+            else if ( viewMode == ViewWorldMode::ViewTowns ) {
+                drawingFlags |= Interface::RedrawLevelType::LEVEL_TOWNS;
+            }
+
+#if !defined( SAVE_WORLD_MAP )
+            drawingFlags ^= Interface::RedrawLevelType::LEVEL_HEROES;
+#endif
+
+            const uint64_t worldHash = getWorldMapHash();
+
+            WorldMapImages & worldMap = getCachedWorldMap( drawingFlags );
+            _baseImages = &worldMap.images;
+
+            if ( worldMap.worldHash == worldHash && worldMap.images.size() == zoomLevels ) {
+                // The world has not been changed since the last time.
+                return;
+            }
+
+            const size_t currentZoomLevelId = static_cast<uint8_t>( currentZoomLevel );
+            assert( currentZoomLevelId < zoomLevels );
+
+            _builder = std::make_unique<ZoomLevelBuilder>( worldMap.images, currentZoomLevelId );
+            _builtZoomLevelId = currentZoomLevelId;
+
+            worldMap.worldHash = worldHash;
+            worldMap.images.resize( zoomLevels );
+
+            renderWorldMap( worldMap.images, drawingFlags, gameArea, currentZoomLevelId, *_builder );
+
+#if defined( SAVE_WORLD_MAP )
+            _builder->wait();
+            fheroes2::Save( worldMap.images[3], Settings::Get().getCurrentMapInfo().name + saveFilePrefix + ".bmp" );
+#endif
+        }
+
+        CacheForMapWithResources( const CacheForMapWithResources & ) = delete;
+
+        ~CacheForMapWithResources()
+        {
+            if ( _builder ) {
+                // Complete all the zoom levels as they are going to be used by the next openings of the View World window.
+                _builder->wait();
+                _builder->stopWorker();
+            }
+        }
+
+        CacheForMapWithResources & operator=( const CacheForMapWithResources & ) = delete;
+
+        // Returns the world map image with object icons for the given zoom level. Waits for this zoom level to be built if necessary.
+        const fheroes2::Image & getImage( const ZoomLevel zoomLevel )
+        {
+            const size_t zoomLevelId = static_cast<uint8_t>( zoomLevel );
+            assert( zoomLevelId < _cachedImages.size() );
+
+            fheroes2::Image & image = _cachedImages[zoomLevelId];
+            if ( !image.empty() ) {
+                return image;
+            }
+
+            if ( _builder && zoomLevelId != _builtZoomLevelId ) {
+                _builder->wait();
+            }
+
+            const fheroes2::Image & baseImage = ( *_baseImages )[zoomLevelId];
+            if ( !_renderIcons ) {
+                return baseImage;
+            }
+
+            image._disableTransformLayer();
+            image.resize( baseImage.width(), baseImage.height() );
+            fheroes2::Copy( baseImage, image );
+
+            DrawObjectsIcons( _color, _viewMode, image, zoomLevelId );
+
+            return image;
+        }
+
+    private:
+        const PlayerColor _color;
+        const ViewWorldMode _viewMode;
+        const bool _renderIcons;
+
+        // Images of the world map without object icons, shared between openings of the View World window.
+        std::vector<fheroes2::Image> * _baseImages{ nullptr };
+
+        // Images of the world map with object icons, built only for zoom levels being shown.
+        std::vector<fheroes2::Image> _cachedImages;
+
+        std::unique_ptr<ZoomLevelBuilder> _builder;
+
+        // The zoom level which is rendered right away, without waiting for the builder.
+        size_t _builtZoomLevelId{ 0 };
+    };
+
     int32_t GetSpriteResource( const ViewWorldMode mode, const bool evil )
     {
         switch ( mode ) {
@@ -649,12 +986,9 @@ void ViewWorld::ViewWorldWindow( const PlayerColor color, const ViewWorldMode mo
 
     ZoomROIs currentROI( zoomLevel, viewCenterInPixels, visibleScreenInPixels, zoomLevels );
 
-    CacheForMapWithResources cache( mode, gameArea, zoomLevels );
+    CacheForMapWithResources cache( color, mode, !interface.isEditor(), gameArea, zoomLevels, currentROI.getZoomLevel() );
 
-    if ( !interface.isEditor() ) {
-        DrawObjectsIcons( color, mode, cache );
-    }
-    else if ( display.height() == fheroes2::Display::DEFAULT_HEIGHT ) {
+    if ( interface.isEditor() && display.height() == fheroes2::Display::DEFAULT_HEIGHT ) {
         // Fix borders for Editor if screen height is 480 pixels.
         const fheroes2::Sprite & borderSprite = fheroes2::AGG::GetICN( isEvilInterface ? ICN::ADVBORDE : ICN::ADVBORD, 0 );
 
@@ -703,7 +1037,7 @@ void ViewWorld::ViewWorldWindow( const PlayerColor color, const ViewWorldMode mo
     }
 
     // Render the View World map image.
-    DrawWorld( currentROI, cache, visibleScreenInPixels );
+    DrawWorld( currentROI, cache.getImage( currentROI.getZoomLevel() ), visibleScreenInPixels );
 
     fheroes2::fadeInDisplay( fadeRoi, false );
 
@@ -762,7 +1096,7 @@ void ViewWorld::ViewWorldWindow( const PlayerColor color, const ViewWorldMode mo
         }
 
         if ( changed ) {
-            DrawWorld( currentROI, cache, visibleScreenInPixels );
+            DrawWorld( currentROI, cache.getImage( currentROI.getZoomLevel() ), visibleScreenInPixels );
             radar.RedrawForViewWorld( currentROI, mode, false );
             display.render();
         }
@@ -793,3 +1127,23 @@ void ViewWorld::ViewWorldWindow( const PlayerColor color, const ViewWorldMode mo
         radar.SetRedraw( Interface::REDRAW_RADAR_CURSOR );
     }
 }
+
+size_t ViewWorld::getCachedImagesMemoryUsage()
+{
+    return getWorldMapCacheMemorySize();
+}
+
+size_t ViewWorld::reduceCachedImagesMemoryUsage( const size_t memoryLimit )
+{
+    validateWorldMapCacheIdentity();
+
+    size_t usedMemory = getWorldMapCacheMemorySize();
+
+    while ( usedMemory > memoryLimit && !worldMapCache.imagesPerDrawingFlags.empty() ) {
+        removeLeastRecentlyUsedWorldMap( std::nullopt );
+
+        usedMemory = getWorldMapCacheMemorySize();
+    }
+
+    return usedMemory;
+}
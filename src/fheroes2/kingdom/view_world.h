@@ -52,6 +52,13 @@ class ViewWorld
 public:
     static void ViewWorldWindow( const PlayerColor color, const ViewWorldMode mode, Interface::BaseInterface & interface );
 
+    // Returns the amount of memory in bytes occupied by the world map images kept between openings of the View World window.
+    static size_t getCachedImagesMemoryUsage();
+
+    // Removes the kept world map images rendered for another map and then the least recently used ones until the occupied memory fits into
+    // the given limit in bytes. Returns the amount of memory still occupied. It must not be called while the View World window is open.
+    static size_t reduceCachedImagesMemoryUsage( const size_t memoryLimit );
+
     class ZoomROIs
     {
     public:
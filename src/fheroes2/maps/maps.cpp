@@ -634,7 +634,7 @@ bool Maps::isTileUnderProtection( const int32_t tileIndex )
 bool Maps::isTileProtectionStrongerThan( const int32_t tileIndex, const double armyStrength )
 {
     // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
-    static Army tileArmy;
+    thread_local Army tileArmy;
     bool isStronger = false;
 
     forEachMonsterProtectingTile( tileIndex, [&armyStrength, &isStronger]( const int32_t monsterIndex ) {
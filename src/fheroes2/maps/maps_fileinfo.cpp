@@ -25,13 +25,17 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <functional>
 #include <list>
 #include <map>
+#include <set>
 #include <sstream>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "color.h"
 #include "difficulty.h"
@@ -49,6 +53,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "tools.h"
 #include "ui_font.h"
 #include "ui_language.h"
@@ -58,6 +63,258 @@ namespace
     const size_t mapNameLength = 16;
     const size_t mapDescriptionLength = 200;
 
+    // "FH2I" in little-endian byte order
+    const uint32_t mapFileIndexMagic = 0x49324846;
+
+    // Must be increased every time the format of the index file is changed.
+    const uint16_t mapFileIndexFormatVersion = 2;
+
+    // Persistent index of map files which allows to avoid reading of every map file each time the list of maps is needed.
+    // A map file is read again only if it is not present in the index or its size or modification time has been changed.
+    class MapFileIndex final
+    {
+    public:
+        // Makes sure that the index contains the up-to-date information about all given map files. Map files which need
+        // to be read are processed in parallel. Map files of the same format which are not given anymore are removed from
+        // the index. The updated index is written to disk.
+        void update( const ListFiles & mapFiles, const bool isOriginalMapFormat )
+        {
+            if ( !_isLoaded ) {
+                _load();
+                _isLoaded = true;
+            }
+
+            const size_t removedEntryCount = _removeMissingEntries( mapFiles, isOriginalMapFormat );
+
+            std::vector<std::pair<const std::string *, Entry *>> entriesToRead;
+
+            for ( const std::string & mapFile : mapFiles ) {
+                uint64_t size = 0;
+                int64_t modificationTime = 0;
+                if ( !System::GetFileSizeAndModificationTime( mapFile, size, modificationTime ) ) {
+                    _entries.erase( mapFile );
+                    continue;
+                }
+
+                Entry & entry = _entries[mapFile];
+                if ( entry.isRead && entry.size == size && entry.modificationTime == modificationTime && entry.isOriginalMapFormat == isOriginalMapFormat ) {
+                    continue;
+                }
+
+                if ( entry.isRead || !entry.isScheduled ) {
+                    entry.size = size;
+                    entry.modificationTime = modificationTime;
+                    entry.isRead = false;
+                    entry.isScheduled = true;
+                    entry.isOriginalMapFormat = isOriginalMapFormat;
+
+                    entriesToRead.emplace_back( &mapFile, &entry );
+                }
+            }
+
+            if ( entriesToRead.empty() ) {
+                if ( removedEntryCount > 0 ) {
+                    DEBUG_LOG( DBG_GAME, DBG_INFO, "Removed " << removedEntryCount << " missing map files from the index" )
+                    _save();
+                }
+
+                return;
+            }
+
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "Reading " << entriesToRead.size() << " new or changed map files out of " << mapFiles.size() )
+
+            // Map files are read in the editor mode to get the information about all map files regardless of the presence of human players.
+            MultiThreading::parallelFor( entriesToRead.size(), MultiThreading::getWorkerCount(),
+                                         [&entriesToRead, isOriginalMapFormat]( const size_t taskId, const uint32_t /* threadId */ ) {
+                                             const auto & [mapFile, entry] = entriesToRead[taskId];
+
+                                             entry->isValid = isOriginalMapFormat ? entry->info.readMP2Map( *mapFile, true )
+                                                                                  : entry->info.readResurrectionMap( *mapFile, true );
+                                             entry->isRead = true;
+                                             entry->isScheduled = false;
+                                         } );
+
+            _save();
+        }
+
+        // Returns the information about the given map file or nullptr if this file is not a valid map.
+        // The index must be updated for this file before calling this method.
+        const Maps::FileInfo * getFileInfo( const std::string & mapFile ) const
+        {
+            const auto iter = _entries.find( mapFile );
+            if ( iter == _entries.end() || !iter->second.isValid ) {
+                return nullptr;
+            }
+
+            assert( iter->second.isRead );
+
+            return &iter->second.info;
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t size{ 0 };
+            int64_t modificationTime{ 0 };
+            bool isRead{ false };
+            bool isScheduled{ false };
+            bool isValid{ false };
+            bool isOriginalMapFormat{ true };
+            Maps::FileInfo info;
+        };
+
+        static std::string _getIndexFilePath()
+        {
+            return System::concatPath( Game::GetCacheDir(), "maps.index" );
+        }
+
+        void _load()
+        {
+            const std::string path = _getIndexFilePath();
+            if ( !System::IsFile( path ) ) {
+                return;
+            }
+
+            StreamFile file;
+            if ( !file.open( path, "rb" ) ) {
+                return;
+            }
+
+            ROStreamBuf stream = file.getStreamBuf();
+            if ( file.fail() ) {
+                return;
+            }
+
+            uint32_t magic = 0;
+            uint16_t indexFormatVersion = 0;
+            uint16_t saveFormatVersion = 0;
+            uint32_t entryCount = 0;
+
+            stream >> magic >> indexFormatVersion >> saveFormatVersion >> entryCount;
+
+            // The information about maps is stored in the same format as in save files.
+            if ( stream.fail() || magic != mapFileIndexMagic || indexFormatVersion != mapFileIndexFormatVersion || saveFormatVersion != CURRENT_FORMAT_VERSION ) {
+                DEBUG_LOG( DBG_GAME, DBG_INFO, "Map file index " << path << " has an unsupported format and will be rebuilt." )
+                return;
+            }
+
+            // The map information deserialization depends on the version of the save file being loaded.
+            const uint16_t originalSaveFileVersion = Game::GetVersionOfCurrentSaveFile();
+            Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+
+            std::map<std::string, Entry> entries;
+
+            for ( uint32_t i = 0; i < entryCount && !stream.fail(); ++i ) {
+                std::string mapFile;
+                uint32_t sizeHigh = 0;
+                uint32_t sizeLow = 0;
+                uint32_t timeHigh = 0;
+                uint32_t timeLow = 0;
+                Entry entry;
+
+                stream >> mapFile >> sizeHigh >> sizeLow >> timeHigh >> timeLow >> entry.isOriginalMapFormat >> entry.isValid;
+
+                entry.size = ( static_cast<uint64_t>( sizeHigh ) << 32 ) | sizeLow;
+                entry.modificationTime = static_cast<int64_t>( ( static_cast<uint64_t>( timeHigh ) << 32 ) | timeLow );
+                entry.isRead = true;
+
+                if ( entry.isValid ) {
+                    stream >> entry.info;
+
+                    // Only the file name is serialized.
+                    entry.info.filename = mapFile;
+                }
+
+                entries.try_emplace( std::move( mapFile ), std::move( entry ) );
+            }
+
+            Game::SetVersionOfCurrentSaveFile( originalSaveFileVersion );
+
+            if ( stream.fail() ) {
+                ERROR_LOG( "Map file index " << path << " is corrupted." )
+                return;
+            }
+
+            _entries = std::move( entries );
+        }
+
+        // Removes the entries of the given map format whose files are absent in the given list. Returns the number of removed entries.
+        size_t _removeMissingEntries( const ListFiles & mapFiles, const bool isOriginalMapFormat )
+        {
+            const std::set<std::string_view> existingMapFiles( mapFiles.begin(), mapFiles.end() );
+
+            size_t removedEntryCount = 0;
+
+            for ( auto iter = _entries.begin(); iter != _entries.end(); ) {
+                if ( iter->second.isOriginalMapFormat == isOriginalMapFormat && existingMapFiles.count( iter->first ) == 0 ) {
+                    iter = _entries.erase( iter );
+                    ++removedEntryCount;
+                }
+                else {
+                    ++iter;
+                }
+            }
+
+            return removedEntryCount;
+        }
+
+        void _save() const
+        {
+            const std::string path = _getIndexFilePath();
+
+            const std::string indexDir = System::GetParentDirectory( path );
+            if ( !System::IsDirectory( indexDir ) && !System::MakeDirectory( indexDir ) ) {
+                ERROR_LOG( "Unable to create a directory for the map file index: " << indexDir )
+                return;
+            }
+
+            RWStreamBuf stream;
+
+            stream << mapFileIndexMagic << mapFileIndexFormatVersion << static_cast<uint16_t>( CURRENT_FORMAT_VERSION );
+
+            // Only the entries which have been read are saved.
+            const uint32_t entryCount
+                = static_cast<uint32_t>( std::count_if( _entries.begin(), _entries.end(), []( const auto & fileEntry ) { return fileEntry.second.isRead; } ) );
+
+            stream << entryCount;
+
+            for ( const auto & [mapFile, entry] : _entries ) {
+                if ( !entry.isRead ) {
+                    continue;
+                }
+
+                const uint64_t modificationTime = static_cast<uint64_t>( entry.modificationTime );
+
+                stream << mapFile << static_cast<uint32_t>( entry.size >> 32 ) << static_cast<uint32_t>( entry.size ) << static_cast<uint32_t>( modificationTime >> 32 )
+                       << static_cast<uint32_t>( modificationTime ) << entry.isOriginalMapFormat << entry.isValid;
+
+                if ( entry.isValid ) {
+                    stream << entry.info;
+                }
+            }
+
+            StreamFile file;
+            if ( !file.open( path, "wb" ) ) {
+                return;
+            }
+
+            file.putRaw( stream.data(), stream.size() );
+
+            if ( file.fail() ) {
+                ERROR_LOG( "Unable to write the map file index to " << path )
+
+                // Do not leave a partially written index file.
+                file.close();
+                System::Unlink( path );
+            }
+        }
+
+        std::map<std::string, Entry> _entries;
+        bool _isLoaded{ false };
+    };
+
+    MapFileIndex mapFileIndex;
+
     // This function returns an unsorted array. It is a caller responsibility to take care of sorting if needed.
     MapsFileInfoList getValidMaps( const ListFiles & mapFiles, const uint8_t humanPlayerCount, const bool isForEditor, const bool isOriginalMapFormat )
     {
@@ -72,23 +329,24 @@ namespace
             = isOriginalMapFormat
               && ( fheroes2::getCurrentLanguage() == fheroes2::SupportedLanguage::French && fheroes2::getResourceLanguage() == fheroes2::SupportedLanguage::French );
 
-        for ( const std::string & mapFile : mapFiles ) {
-            Maps::FileInfo fi;
+        mapFileIndex.update( mapFiles, isOriginalMapFormat );
 
-            if ( isOriginalMapFormat ) {
-                if ( !fi.readMP2Map( mapFile, isForEditor ) ) {
-                    continue;
-                }
-            }
-            else {
-                if ( !fi.readResurrectionMap( mapFile, isForEditor ) ) {
-                    continue;
-                }
+        for ( const std::string & mapFile : mapFiles ) {
+            const Maps::FileInfo * indexedFileInfo = mapFileIndex.getFileInfo( mapFile );
+            if ( indexedFileInfo == nullptr ) {
+                continue;
             }
 
+            Maps::FileInfo fi = *indexedFileInfo;
+
             if ( !isForEditor ) {
                 assert( humanPlayerCount >= 1 );
 
+                if ( fi.colorsAvailableForHumans == 0 ) {
+                    // This is not a valid map since no human players exist so it cannot be played.
+                    continue;
+                }
+
                 const int humanOnlyColorsCount = Color::Count( fi.HumanOnlyColors() );
                 if ( humanOnlyColorsCount > humanPlayerCount ) {
                     // This map requires more human-only players than needed.
@@ -500,7 +500,23 @@ void Maps::Tile::setMainObjectType( const MP2::MapObjectType objectType )
 {
     _mainObjectType = objectType;
 
-    world.resetPathfinder();
+    world.markPathfinderTileAsChanged( _index );
+    world.markRadarTileAsChanged( _index );
+    world.markTerrainTileAsChanged( _index );
+}
+
+Maps::ObjectPart & Maps::Tile::getMainObjectPart()
+{
+    world.markTerrainTileAsChanged( _index );
+
+    return _mainObjectPart;
+}
+
+void Maps::Tile::resetMainObjectPart()
+{
+    _mainObjectPart = {};
+
+    world.markTerrainTileAsChanged( _index );
 }
 
 void Maps::Tile::setBoat( const int direction, const PlayerColor color )
@@ -827,6 +843,25 @@ void Maps::Tile::pushGroundObjectPart( ObjectPart part )
     }
 
     _groundObjectPart.emplace_back( part );
+
+    world.markTerrainTileAsChanged( _index );
+}
+
+std::list<Maps::ObjectPart> & Maps::Tile::getGroundObjectParts()
+{
+    world.markTerrainTileAsChanged( _index );
+
+    return _groundObjectPart;
+}
+
+void Maps::Tile::moveMainObjectPartToGroundLevel()
+{
+    if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
+        _groundObjectPart.emplace_back( _mainObjectPart );
+        _mainObjectPart = {};
+
+        world.markTerrainTileAsChanged( _index );
+    }
 }
 
 void Maps::Tile::sortObjectParts()
@@ -836,6 +871,8 @@ void Maps::Tile::sortObjectParts()
         return;
     }
 
+    world.markTerrainTileAsChanged( _index );
+
     // Push everything to the container and sort it by level.
     if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
         _groundObjectPart.emplace_front( _mainObjectPart );
@@ -869,6 +906,8 @@ void Maps::Tile::sortObjectParts()
 
 Maps::ObjectPart * Maps::Tile::getGroundObjectPart( const uint32_t uid )
 {
+    world.markTerrainTileAsChanged( _index );
+
     auto it = std::find_if( _groundObjectPart.begin(), _groundObjectPart.end(), [uid]( const auto & v ) { return v._uid == uid; } );
 
     return it != _groundObjectPart.end() ? &( *it ) : nullptr;
@@ -1280,6 +1319,8 @@ void Maps::Tile::setOwnershipFlag( const MP2::MapObjectType objectType, PlayerCo
 
 void Maps::Tile::updateFlag( const PlayerColor color, const uint8_t objectSpriteIndex, const uint32_t uid, const bool setOnUpperLayer )
 {
+    world.markTerrainTileAsChanged( _index );
+
     // Flag deletion or installation must be done in relation to object UID as flag is attached to the object.
     if ( color == PlayerColor::NONE ) {
         const auto isFlag = [uid]( const auto & part ) { return part._uid == uid && part.icnType == MP2::OBJ_ICN_TYPE_FLAG32; };
@@ -1468,6 +1509,8 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
     }
 
     if ( isObjectPartRemoved ) {
+        world.markTerrainTileAsChanged( _index );
+
         // Since an object part was removed we have to update main object type.
         updateObjectType();
 
@@ -1513,12 +1556,16 @@ void Maps::Tile::removeObjects( const MP2::ObjectIcnType objectIcnType )
 
     _updateRoadFlag();
 
+    world.markTerrainTileAsChanged( _index );
+
     // TODO: update tile's object type after objects' removal.
 }
 
 void Maps::Tile::replaceObject( const uint32_t objectUid, const MP2::ObjectIcnType originalObjectIcnType, const MP2::ObjectIcnType newObjectIcnType,
                                 const uint8_t originalImageIndex, const uint8_t newImageIndex )
 {
+    world.markTerrainTileAsChanged( _index );
+
     // We can immediately return from the function as only one object per tile can have the same UID.
     for ( auto & part : _groundObjectPart ) {
         if ( part._uid == objectUid && part.icnType == originalObjectIcnType && part.icnIndex == originalImageIndex ) {
@@ -1544,6 +1591,8 @@ void Maps::Tile::replaceObject( const uint32_t objectUid, const MP2::ObjectIcnTy
 
 void Maps::Tile::updateObjectImageIndex( const uint32_t objectUid, const MP2::ObjectIcnType objectIcnType, const int imageIndexOffset )
 {
+    world.markTerrainTileAsChanged( _index );
+
     // We can immediately return from the function as only one object per tile can have the same UID.
     for ( auto & part : _groundObjectPart ) {
         if ( part._uid == objectUid && part.icnType == objectIcnType ) {
@@ -1567,18 +1616,29 @@ void Maps::Tile::updateObjectImageIndex( const uint32_t objectUid, const MP2::Ob
     }
 }
 
+void Maps::Tile::setTerrain( const uint16_t terrainImageIndex, const uint8_t terrainFlags )
+{
+    _terrainFlags = terrainFlags;
+    _terrainImageIndex = terrainImageIndex;
+
+    world.markTerrainTileAsChanged( _index );
+}
+
 void Maps::Tile::ClearFog( const PlayerColorsSet colors )
 {
     _fogColors &= ~colors;
 
     // The fog might be cleared even without the hero's movement - for example, the hero can gain a new level of Scouting
     // skill by picking up a Treasure Chest from a nearby tile or buying a map in a Magellan's Maps object using the space
-    // bar button. Reset the pathfinder(s) to make the newly discovered tiles immediately available for this hero.
-    world.resetPathfinder();
+    // bar button. Update the pathfinder(s) to make the newly discovered tiles immediately available for this hero.
+    world.markPathfinderTileAsChanged( _index );
+    world.markRadarTileAsChanged( _index );
 }
 
 void Maps::Tile::updateTileObjectIcnIndex( Maps::Tile & tile, const uint32_t uid, const uint8_t newIndex )
 {
+    world.markTerrainTileAsChanged( tile._index );
+
     ObjectPart * part = tile.getGroundObjectPart( uid );
     if ( part != nullptr ) {
         part->icnIndex = newIndex;
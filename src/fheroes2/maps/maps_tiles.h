@@ -143,10 +143,8 @@ namespace Maps
             return _mainObjectPart;
         }
 
-        ObjectPart & getMainObjectPart()
-        {
-            return _mainObjectPart;
-        }
+        // Non-const access to object parts marks the tile as changed for the rendering.
+        ObjectPart & getMainObjectPart();
 
         uint16_t GetPassable() const
         {
@@ -219,10 +217,7 @@ namespace Maps
         void setBoat( const int direction, const PlayerColor color );
         int getBoatDirection() const;
 
-        void resetMainObjectPart()
-        {
-            _mainObjectPart = {};
-        }
+        void resetMainObjectPart();
 
         uint32_t GetRegion() const
         {
@@ -260,23 +255,14 @@ namespace Maps
             return _groundObjectPart;
         }
 
-        std::list<ObjectPart> & getGroundObjectParts()
-        {
-            return _groundObjectPart;
-        }
+        std::list<ObjectPart> & getGroundObjectParts();
 
         const std::list<ObjectPart> & getTopObjectParts() const
         {
             return _topObjectPart;
         }
 
-        void moveMainObjectPartToGroundLevel()
-        {
-            if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
-                _groundObjectPart.emplace_back( _mainObjectPart );
-                _mainObjectPart = {};
-            }
-        }
+        void moveMainObjectPartToGroundLevel();
 
         void sortObjectParts();
 
@@ -333,11 +319,7 @@ namespace Maps
             return _terrainImageIndex;
         }
 
-        void setTerrain( const uint16_t terrainImageIndex, const uint8_t terrainFlags )
-        {
-            _terrainFlags = terrainFlags;
-            _terrainImageIndex = terrainImageIndex;
-        }
+        void setTerrain( const uint16_t terrainImageIndex, const uint8_t terrainFlags );
 
         Heroes * getHero() const;
         void setHero( Heroes * hero );
@@ -24,6 +24,7 @@
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
+#include <initializer_list>
 #include <list>
 #include <map>
 #include <ostream>
@@ -984,6 +985,69 @@ namespace Maps
         }
     }
 
+    bool isTileGroundStatic( const Tile & tile, const Interface::GameArea & area )
+    {
+        const auto isPartStatic = [&area]( const ObjectPart & part ) {
+            if ( part.icnType == MP2::OBJ_ICN_TYPE_UNKNOWN || part.layerType == OBJECT_LAYER ) {
+                return true;
+            }
+
+            // Flags are rendered after the main object of the tile.
+            if ( part.icnType == MP2::OBJ_ICN_TYPE_FLAG32 || area.getObjectAlphaValue( part._uid ) != 255 ) {
+                return false;
+            }
+
+            const auto * objectInfo = Maps::getObjectPartByIcn( part.icnType, part.icnIndex );
+            return objectInfo == nullptr || objectInfo->animationFrames == 0;
+        };
+
+        for ( const auto & part : tile.getGroundObjectParts() ) {
+            if ( !isPartStatic( part ) ) {
+                return false;
+            }
+        }
+
+        return isPartStatic( tile.getMainObjectPart() );
+    }
+
+    void renderTileGround( const Tile & tile, fheroes2::Image & output, const fheroes2::Point & offset )
+    {
+        fheroes2::Copy( getTileSurface( tile ), 0, 0, output, offset.x, offset.y, fheroes2::tileWidthPx, fheroes2::tileWidthPx );
+
+        const auto renderPart = [&output, &offset]( const int icn, const ObjectPart & part ) {
+            const fheroes2::Sprite & sprite = fheroes2::AGG::GetICN( icn, part.icnIndex );
+
+            // If this assertion blows up we are trying to render an image bigger than a tile.
+            assert( sprite.x() >= 0 && sprite.width() + sprite.x() <= fheroes2::tileWidthPx && sprite.y() >= 0 && sprite.height() + sprite.y() <= fheroes2::tileWidthPx );
+
+            fheroes2::Blit( sprite, output, offset.x + sprite.x(), offset.y + sprite.y() );
+        };
+
+        const ObjectPart & mainPart = tile.getMainObjectPart();
+
+        // The same order of levels is used as in Interface::GameArea::Redraw().
+        for ( const uint8_t level : { TERRAIN_LAYER, BACKGROUND_LAYER, SHADOW_LAYER } ) {
+            for ( const auto & part : tile.getGroundObjectParts() ) {
+                // Tiles with flags are never static.
+                if ( part.layerType != level || part.icnType == MP2::OBJ_ICN_TYPE_FLAG32 ) {
+                    continue;
+                }
+
+                const int icn = MP2::getIcnIdFromObjectIcnType( part.icnType );
+                if ( !isObjectPartDirectRenderingRestricted( icn ) ) {
+                    renderPart( icn, part );
+                }
+            }
+
+            if ( mainPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN && mainPart.layerType == level ) {
+                const int icn = MP2::getIcnIdFromObjectIcnType( mainPart.icnType );
+                if ( !isTileDirectRenderingRestricted( icn, tile.getMainObjectType() ) ) {
+                    renderPart( icn, mainPart );
+                }
+            }
+        }
+    }
+
     void drawByObjectIcnType( const Tile & tile, fheroes2::Image & output, const Interface::GameArea & area, const MP2::ObjectIcnType objectIcnType )
     {
         const fheroes2::Point & tileOffset = Maps::GetPoint( tile.GetIndex() );
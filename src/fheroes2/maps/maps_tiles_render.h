@@ -61,6 +61,14 @@ namespace Maps
 
     void redrawBottomLayerObjects( const Tile & tile, fheroes2::Image & dst, bool isPuzzleDraw, const Interface::GameArea & area, const uint8_t level );
 
+    // Returns true if the terrain and all object parts of the tile which are rendered below the object layer (roads, rivers, background objects
+    // and shadows) are not animated and are fully opaque, so they can be rendered once and reused by the following frames.
+    bool isTileGroundStatic( const Tile & tile, const Interface::GameArea & area );
+
+    // Renders the terrain and all object parts of the tile which are rendered below the object layer without any animation and transparency.
+    // The tile is rendered at the given offset of the output image which is not related to the game area.
+    void renderTileGround( const Tile & tile, fheroes2::Image & output, const fheroes2::Point & offset );
+
     void drawByObjectIcnType( const Tile & tile, fheroes2::Image & output, const Interface::GameArea & area, const MP2::ObjectIcnType objectIcnType );
 
     std::vector<fheroes2::ObjectRenderingInfo> getMonsterSpritesPerTile( const Tile & tile, const bool isEditorMode );
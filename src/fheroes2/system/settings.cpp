@@ -92,6 +92,13 @@ namespace
     };
 
     const int defaultSpeedDelay{ 5 };
+
+#if defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH )
+    // Handheld devices have a very limited amount of memory.
+    const int defaultImageCacheMemoryLimit{ 96 };
+#else
+    const int defaultImageCacheMemoryLimit{ 0 };
+#endif
 }
 
 std::string Settings::GetVersion()
@@ -108,6 +115,7 @@ Settings::Settings()
     , music_volume( 6 )
     , _musicType( MUSIC_EXTERNAL )
     , _controllerPointerSpeed( 10 )
+    , _imageCacheMemoryLimit( defaultImageCacheMemoryLimit )
     , heroes_speed( defaultSpeedDelay )
     , ai_speed( defaultSpeedDelay )
     , scroll_speed( SCROLL_SPEED_NORMAL )
@@ -299,6 +307,10 @@ bool Settings::Read( const std::string & filePath )
         _controllerPointerSpeed = std::clamp( config.IntParams( "controller pointer speed" ), 0, 100 );
     }
 
+    if ( config.Exists( "image cache memory limit" ) ) {
+        _imageCacheMemoryLimit = std::max( config.IntParams( "image cache memory limit" ), 0 );
+    }
+
     if ( config.Exists( "first time game run" ) && config.StrParams( "first time game run" ) == "off" ) {
         resetFirstGameRun();
     }
@@ -511,6 +523,9 @@ std::string Settings::String() const
     os << std::endl << "# Controller pointer speed: 0 - 100" << std::endl;
     os << "controller pointer speed = " << _controllerPointerSpeed << std::endl;
 
+    os << std::endl << "# Memory limit in megabytes for the loaded game images, 0 means no limit" << std::endl;
+    os << "image cache memory limit = " << _imageCacheMemoryLimit << std::endl;
+
     os << std::endl << "# First time game run (show additional hints): on/off" << std::endl;
     os << "first time game run = " << ( _gameOptions.Modes( GAME_FIRST_RUN ) ? "on" : "off" ) << std::endl;
 
@@ -362,6 +362,12 @@ public:
         return _controllerPointerSpeed;
     }
 
+    // Returns the memory limit in megabytes for the images loaded from AGG files. 0 means no limit.
+    int imageCacheMemoryLimit() const
+    {
+        return _imageCacheMemoryLimit;
+    }
+
     ZoomLevel ViewWorldZoomLevel() const
     {
         return _viewWorldZoomLevel;
@@ -425,6 +431,7 @@ private:
     int music_volume;
     MusicSource _musicType;
     int _controllerPointerSpeed;
+    int _imageCacheMemoryLimit;
     int heroes_speed;
     int ai_speed;
     int scroll_speed;
@@ -31,6 +31,7 @@
 #include <ostream>
 #include <set>
 #include <tuple>
+#include <utility>
 
 #include "ai_planner.h"
 #include "artifact.h"
@@ -337,6 +338,11 @@ void World::Reset()
     heroIdAsLossCondition = Heroes::UNKNOWN;
 
     _seed = 0;
+
+    _radarChangedTiles.clear();
+    _terrainChangedTiles.clear();
+
+    ++_mapGeneration;
 }
 
 void World::generateBattleOnlyMap()
@@ -344,9 +350,12 @@ void World::generateBattleOnlyMap()
     const std::vector<int> terrainTypes{ Maps::Ground::DESERT, Maps::Ground::SNOW, Maps::Ground::SWAMP, Maps::Ground::WASTELAND, Maps::Ground::BEACH,
                                          Maps::Ground::LAVA,   Maps::Ground::DIRT, Maps::Ground::GRASS, Maps::Ground::WATER };
 
-    generateUninitializedMap( 2 );
+    generateBattleOnlyMap( Rand::Get( terrainTypes ) );
+}
 
-    const int groundType = Rand::Get( terrainTypes );
+void World::generateBattleOnlyMap( const int groundType )
+{
+    generateUninitializedMap( 2 );
 
     for ( size_t i = 0; i < vec_tiles.size(); ++i ) {
         vec_tiles[i].setIndex( static_cast<int32_t>( i ) );
@@ -870,6 +879,11 @@ void World::CaptureObject( const int32_t index, const PlayerColor color )
     // In example, dwellings can also marked by the player's color.
     map_captureobj.Set( index, objectType, color );
 
+    // All tiles of the captured object are shown on the radar with the owner's color. These tiles are located above and on both sides
+    // of the main tile, castles also occupy the row below it.
+    const fheroes2::Point center = Maps::GetPoint( index );
+    markRadarAreaAsChanged( { center.x - 3, center.y - 3, 7, 5 } );
+
     if ( color != PlayerColor::NONE && !( Color::allPlayerColors() & color ) ) {
         return;
     }
@@ -895,6 +909,9 @@ CapturedObject & World::GetCapturedObject( const int32_t index )
 void World::ResetCapturedObjects( const PlayerColor color )
 {
     map_captureobj.ResetColor( color );
+
+    // The objects and castles of this player are spread all over the map.
+    markRadarAreaAsChanged( { 0, 0, width, height } );
 }
 
 void World::ClearFog( PlayerColor color ) const
@@ -1281,6 +1298,75 @@ void World::resetPathfinder()
     AI::Planner::Get().resetPathfinder();
 }
 
+void World::markPathfinderTileAsChanged( const int32_t tileIndex )
+{
+    _pathfinder.markTileAsChanged( tileIndex );
+    AI::Planner::Get().markPathfinderTileAsChanged( tileIndex );
+}
+
+void World::ChangedTiles::mark( const int32_t tileIndex, const size_t tileCount )
+{
+    if ( isChanged.size() != tileCount ) {
+        indexes.clear();
+        isChanged.assign( tileCount, 0 );
+    }
+
+    if ( isChanged[tileIndex] ) {
+        return;
+    }
+
+    isChanged[tileIndex] = 1;
+    indexes.push_back( tileIndex );
+}
+
+std::vector<int32_t> World::ChangedTiles::take()
+{
+    for ( const int32_t tileIndex : indexes ) {
+        isChanged[tileIndex] = 0;
+    }
+
+    return std::exchange( indexes, {} );
+}
+
+void World::markRadarTileAsChanged( const int32_t tileIndex )
+{
+    if ( !Maps::isValidAbsIndex( tileIndex ) ) {
+        return;
+    }
+
+    _radarChangedTiles.mark( tileIndex, vec_tiles.size() );
+}
+
+void World::markRadarAreaAsChanged( const fheroes2::Rect & area )
+{
+    const fheroes2::Rect roi = area ^ fheroes2::Rect( 0, 0, width, height );
+
+    for ( int32_t y = roi.y; y < roi.y + roi.height; ++y ) {
+        for ( int32_t x = roi.x; x < roi.x + roi.width; ++x ) {
+            markRadarTileAsChanged( y * width + x );
+        }
+    }
+}
+
+std::vector<int32_t> World::takeRadarChangedTiles()
+{
+    return _radarChangedTiles.take();
+}
+
+void World::markTerrainTileAsChanged( const int32_t tileIndex )
+{
+    if ( !Maps::isValidAbsIndex( tileIndex ) ) {
+        return;
+    }
+
+    _terrainChangedTiles.mark( tileIndex, vec_tiles.size() );
+}
+
+std::vector<int32_t> World::takeTerrainChangedTiles()
+{
+    return _terrainChangedTiles.take();
+}
+
 void World::updatePassabilities()
 {
     for ( Maps::Tile & tile : vec_tiles ) {
@@ -1560,6 +1646,11 @@ OStreamBase & operator<<( OStreamBase & stream, const World & w )
 
 IStreamBase & operator>>( IStreamBase & stream, World & w )
 {
+    // The whole map is replaced, so the changes of the previous map are not relevant anymore.
+    w._radarChangedTiles.clear();
+    w._terrainChangedTiles.clear();
+    ++w._mapGeneration;
+
     static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1010_RELEASE, "Remove the logic below." );
     if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_1010_RELEASE ) {
         uint16_t width = 0;
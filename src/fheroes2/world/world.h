@@ -207,9 +207,12 @@ public:
 
     bool loadResurrectionMap( const std::string & filename );
 
-    // Generate 2x2 map for Battle Only mode.
+    // Generate 2x2 map for Battle Only mode with a random terrain.
     void generateBattleOnlyMap();
 
+    // Generate 2x2 map for Battle Only mode with the given terrain.
+    void generateBattleOnlyMap( const int groundType );
+
     // Generates a map without initializing tiles.
     // WARNING: call this method only when reading a map from a file
     void generateUninitializedMap( const int32_t size );
@@ -428,6 +431,31 @@ public:
     std::list<Route::Step> getPath( const Heroes & hero, int targetIndex );
     void resetPathfinder();
 
+    // Informs all pathfinders that the given tile has been changed so that only the affected parts of their caches will be re-evaluated.
+    void markPathfinderTileAsChanged( const int32_t tileIndex );
+
+    // Informs the radar that the appearance of the given tile(s) on the radar might have been changed so that only these tiles will be
+    // re-evaluated during the next radar redraw.
+    void markRadarTileAsChanged( const int32_t tileIndex );
+    void markRadarAreaAsChanged( const fheroes2::Rect & area );
+
+    // Returns the indexes of all tiles marked as changed for the radar since the previous call of this method.
+    std::vector<int32_t> takeRadarChangedTiles();
+
+    // Informs the adventure map that the terrain or the objects below the object layer might have been changed on the given tile so that
+    // the pre-rendered terrain containing this tile will be re-rendered.
+    void markTerrainTileAsChanged( const int32_t tileIndex );
+
+    // Returns the indexes of all tiles marked as changed for the terrain rendering since the previous call of this method.
+    std::vector<int32_t> takeTerrainChangedTiles();
+
+    // Returns a number which is changed every time the whole map is replaced (by loading another map or a saved game, or by re-creating
+    // the map in the Editor), so everything cached for the previous map should be discarded.
+    uint32_t getMapGeneration() const
+    {
+        return _mapGeneration;
+    }
+
     void ComputeStaticAnalysis();
 
     uint32_t GetMapSeed() const
@@ -451,6 +479,23 @@ public:
     void fixFrenchCharactersInStrings();
 
 private:
+    // Indexes of changed tiles which are collected until they are taken by the consumer. Every tile index is stored only once.
+    struct ChangedTiles
+    {
+        void mark( const int32_t tileIndex, const size_t tileCount );
+
+        std::vector<int32_t> take();
+
+        void clear()
+        {
+            indexes.clear();
+            isChanged.clear();
+        }
+
+        std::vector<int32_t> indexes;
+        std::vector<uint8_t> isChanged;
+    };
+
     World() = default;
 
     void Defaults();
@@ -510,6 +555,14 @@ private:
     double _landRoughness{ 1.0 };
     std::vector<MapRegion> _regions;
     PlayerWorldPathfinder _pathfinder;
+
+    // Tiles whose appearance on the radar might have been changed since the previous radar redraw.
+    ChangedTiles _radarChangedTiles;
+
+    // Tiles whose terrain might have been changed since the previous redraw of the adventure map.
+    ChangedTiles _terrainChangedTiles;
+
+    uint32_t _mapGeneration{ 0 };
 };
 
 OStreamBase & operator<<( OStreamBase & stream, const CapturedObject & obj );
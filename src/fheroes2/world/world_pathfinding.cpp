@@ -79,7 +79,7 @@ namespace
 
         const auto isTileAccessible = [color, armyStrength, minimalAdvantage, &tile]() {
             // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
-            static Army tileArmy;
+            thread_local Army tileArmy;
             tileArmy.setFromTile( tile );
 
             const PlayerColor tileArmyColor = tileArmy.GetColor();
@@ -300,6 +300,13 @@ namespace
         return !Maps::isTileProtectionStrongerThan( tileIndex, armyStrength / minimalAdvantage );
     }
 
+    // If the number of changed tiles exceeds this fraction of the map size, then it is cheaper to re-evaluate the whole map
+    const size_t maxChangedTilesFraction = 16;
+
+    // The passability of a tile and the movement penalties from this tile depend on the adjacent tiles (e.g. monsters protecting
+    // the tile or land corners on the water), so a change of a tile can affect paths that pass at this distance from the tile
+    const int32_t changedTileImpactDistance = 2;
+
     uint32_t subtractMovePoints( const uint32_t movePoints, const uint32_t subtractedMovePoints, const uint32_t maxMovePoints )
     {
         // We do not perform pathfinding for a real hero on the map, this is no-op
@@ -320,11 +327,29 @@ namespace
     }
 }
 
+void WorldNodeCache::resize( const size_t size )
+{
+    _from.resize( size );
+    _cost.resize( size );
+    _remainingMovePoints.resize( size );
+    _aiProperties.resize( size );
+
+    clear();
+}
+
+void WorldNodeCache::clear()
+{
+    std::fill( _from.begin(), _from.end(), -1 );
+    std::fill( _cost.begin(), _cost.end(), 0 );
+    std::fill( _remainingMovePoints.begin(), _remainingMovePoints.end(), 0 );
+    std::fill( _aiProperties.begin(), _aiProperties.end(), static_cast<uint8_t>( 0 ) );
+}
+
 uint32_t WorldPathfinder::getDistance( int targetIndex ) const
 {
     assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
 
-    return _cache[targetIndex]._cost;
+    return _cache.getCost( targetIndex );
 }
 
 uint32_t WorldPathfinder::getMovementPenalty( const int from, const int to, const int direction ) const
@@ -344,12 +369,10 @@ uint32_t WorldPathfinder::getMovementPenalty( const int from, const int to, cons
     // tile (both in straight and diagonal direction) as long as we have enough movement points
     // to move over our current tile in the straight direction
     if ( getMaxMovePoints( fromTile.isWater() ) > 0 ) {
-        const WorldNode & node = _cache[from];
-
         // No dead ends allowed
-        assert( from == _pathStart || node._from != -1 );
+        assert( from == _pathStart || _cache.getFrom( from ) != -1 );
 
-        const uint32_t remainingMovePoints = node._remainingMovePoints;
+        const uint32_t remainingMovePoints = _cache.getRemainingMovePoints( from );
         const uint32_t fromTilePenalty = fromTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( fromTile, _pathfindingSkill );
 
         // If we still have enough movement points to move over the source tile in the straight
@@ -384,17 +407,38 @@ void WorldPathfinder::reset()
     _color = PlayerColor::NONE;
     _remainingMovePoints = 0;
     _pathfindingSkill = Skill::Level::EXPERT;
+
+    _changedTiles.clear();
+}
+
+void WorldPathfinder::markTileAsChanged( const int32_t tileIndex )
+{
+    // The cache is not evaluated yet, there is nothing to repair
+    if ( _pathStart == -1 ) {
+        return;
+    }
+
+    // The world is being (re)loaded
+    if ( _cache.size() != world.getSize() || !Maps::isValidAbsIndex( tileIndex ) ) {
+        reset();
+        return;
+    }
+
+    _changedTiles.push_back( tileIndex );
+
+    if ( _changedTiles.size() > _cache.size() / maxChangedTilesFraction ) {
+        reset();
+    }
 }
 
 void WorldPathfinder::processWorldMap()
 {
     assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
 
-    for ( WorldNode & node : _cache ) {
-        node = {};
-    }
+    _changedTiles.clear();
 
-    _cache[_pathStart].update( -1, 0, _remainingMovePoints );
+    _cache.clear();
+    _cache.update( _pathStart, -1, 0, _remainingMovePoints );
 
     std::vector<int> nodesToExplore;
     nodesToExplore.push_back( _pathStart );
@@ -404,10 +448,106 @@ void WorldPathfinder::processWorldMap()
     }
 }
 
+void WorldPathfinder::repairWorldMap()
+{
+    assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) && !_changedTiles.empty() );
+
+    std::vector<uint8_t> isNodeInvalidated( _cache.size(), 0 );
+
+    // First, invalidate all nodes located close to the changed tiles. Cached AI-specific properties of these tiles are also reset.
+    for ( const int32_t changedTileIdx : _changedTiles ) {
+        Maps::Indexes nearbyIndexes = Maps::getAroundIndexes( changedTileIdx, changedTileImpactDistance );
+        nearbyIndexes.push_back( changedTileIdx );
+
+        for ( const int32_t idx : nearbyIndexes ) {
+            // The starting tile has been changed, there is no other way than to re-evaluate the whole map
+            if ( idx == _pathStart ) {
+                processWorldMap();
+                return;
+            }
+
+            isNodeInvalidated[idx] = 1;
+            _cache.clearNode( idx );
+        }
+    }
+
+    _changedTiles.clear();
+
+    // Then invalidate all nodes whose paths pass through the invalidated nodes
+    {
+        std::vector<uint8_t> isNodeChecked( _cache.size(), 0 );
+        std::vector<int> pathNodes;
+
+        isNodeChecked[_pathStart] = 1;
+
+        for ( size_t i = 0; i < _cache.size(); ++i ) {
+            int nodeIdx = static_cast<int>( i );
+
+            while ( !isNodeChecked[nodeIdx] && !isNodeInvalidated[nodeIdx] && _cache.getFrom( nodeIdx ) != -1 ) {
+                isNodeChecked[nodeIdx] = 1;
+                pathNodes.push_back( nodeIdx );
+
+                nodeIdx = _cache.getFrom( nodeIdx );
+            }
+
+            if ( isNodeInvalidated[nodeIdx] ) {
+                for ( const int pathNodeIdx : pathNodes ) {
+                    isNodeInvalidated[pathNodeIdx] = 1;
+                    _cache.reset( pathNodeIdx );
+                }
+            }
+
+            pathNodes.clear();
+        }
+    }
+
+    // If most of the nodes have been invalidated, then there is no point to repair them one by one
+    if ( static_cast<size_t>( std::count( isNodeInvalidated.begin(), isNodeInvalidated.end(), static_cast<uint8_t>( 1 ) ) ) > _cache.size() / 2 ) {
+        processWorldMap();
+        return;
+    }
+
+    // All valid nodes from which it is possible to move to the invalidated nodes should be explored again
+    std::vector<int> nodesToExplore;
+
+    const Directions & directions = Direction::All();
+
+    for ( size_t i = 0; i < _cache.size(); ++i ) {
+        const int nodeIdx = static_cast<int>( i );
+
+        if ( isNodeInvalidated[nodeIdx] || ( nodeIdx != _pathStart && _cache.getFrom( nodeIdx ) == -1 ) ) {
+            continue;
+        }
+
+        for ( size_t j = 0; j < directions.size(); ++j ) {
+            if ( Maps::isValidDirection( nodeIdx, directions[j] ) && isNodeInvalidated[nodeIdx + _mapOffset[j]] ) {
+                nodesToExplore.push_back( nodeIdx );
+                break;
+            }
+        }
+    }
+
+    addNonAdjacentRepairNodes( nodesToExplore, isNodeInvalidated );
+
+    // Explore the nodes in the same order in which they would be explored during the full evaluation as much as possible
+    std::sort( nodesToExplore.begin(), nodesToExplore.end(), [this]( const int left, const int right ) {
+        return std::make_pair( _cache.getCost( left ), left ) < std::make_pair( _cache.getCost( right ), right );
+    } );
+    nodesToExplore.erase( std::unique( nodesToExplore.begin(), nodesToExplore.end() ), nodesToExplore.end() );
+
+    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
+        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
+    }
+}
+
+void WorldPathfinder::addNonAdjacentRepairNodes( std::vector<int> & /* nodesToExplore */, const std::vector<uint8_t> & /* isNodeInvalidated */ )
+{
+    // Do nothing.
+}
+
 void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, const int currentNodeIdx )
 {
     const Directions & directions = Direction::All();
-    const WorldNode & currentNode = _cache[currentNodeIdx];
     const uint32_t maxMovePoints = getMaxMovePoints( world.getTile( currentNodeIdx ).isWater() );
 
     for ( size_t i = 0; i < directions.size(); ++i ) {
@@ -421,12 +561,11 @@ void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, con
         }
 
         const uint32_t movementPenalty = getMovementPenalty( currentNodeIdx, newIndex, directions[i] );
-        const uint32_t movementCost = currentNode._cost + movementPenalty;
+        const uint32_t movementCost = _cache.getCost( currentNodeIdx ) + movementPenalty;
 
-        WorldNode & newNode = _cache[newIndex];
-
-        if ( newNode._from == -1 || newNode._cost > movementCost ) {
-            newNode.update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
+        if ( _cache.getFrom( newIndex ) == -1 || _cache.getCost( newIndex ) > movementCost ) {
+            _cache.update( newIndex, currentNodeIdx, movementCost,
+                           subtractMovePoints( _cache.getRemainingMovePoints( currentNodeIdx ), movementPenalty, maxMovePoints ) );
 
             nodesToExplore.push_back( newIndex );
         }
@@ -456,6 +595,9 @@ void PlayerWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
 
         processWorldMap();
     }
+    else if ( !_changedTiles.empty() ) {
+        repairWorldMap();
+    }
 }
 
 std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex ) const
@@ -465,7 +607,7 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
     std::list<Route::Step> path;
 
     // Destination is not reachable
-    if ( _cache[targetIndex]._cost == 0 ) {
+    if ( _cache.getCost( targetIndex ) == 0 ) {
         return path;
     }
 
@@ -478,18 +620,18 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
     while ( currentNode != _pathStart ) {
         assert( currentNode != -1 );
 
-        const WorldNode & node = _cache[currentNode];
+        const int from = _cache.getFrom( currentNode );
 
-        assert( node._from != -1 );
+        assert( from != -1 );
 
-        const uint32_t cost = node._cost - _cache[node._from]._cost;
+        const uint32_t cost = _cache.getCost( currentNode ) - _cache.getCost( from );
 
-        path.emplace_front( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
+        path.emplace_front( currentNode, from, Maps::GetDirection( from, currentNode ), cost );
 
         // The path should not pass through the same tile more than once
-        assert( uniqPathIndexes.insert( node._from ).second );
+        assert( uniqPathIndexes.insert( from ).second );
 
-        currentNode = node._from;
+        currentNode = from;
     }
 
     return path;
@@ -498,7 +640,6 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
 void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
-    const WorldNode & currentNode = _cache[currentNodeIdx];
     const bool fromWater = world.getTile( _pathStart ).isWater();
 
     if ( !isFirstNode && !isTileAvailableForWalkThrough( currentNodeIdx, fromWater ) ) {
@@ -519,12 +660,11 @@ void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplor
             }
 
             const uint32_t movementPenalty = getMovementPenalty( currentNodeIdx, monsterIndex, direction );
-            const uint32_t movementCost = currentNode._cost + movementPenalty;
+            const uint32_t movementCost = _cache.getCost( currentNodeIdx ) + movementPenalty;
 
-            WorldNode & monsterNode = _cache[monsterIndex];
-
-            if ( monsterNode._from == -1 || monsterNode._cost > movementCost ) {
-                monsterNode.update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
+            if ( _cache.getFrom( monsterIndex ) == -1 || _cache.getCost( monsterIndex ) > movementCost ) {
+                _cache.update( monsterIndex, currentNodeIdx, movementCost,
+                               subtractMovePoints( _cache.getRemainingMovePoints( currentNodeIdx ), movementPenalty, maxMovePoints ) );
             }
         }
     }
@@ -641,6 +781,9 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
 
         processWorldMap();
     }
+    else if ( !_changedTiles.empty() ) {
+        repairWorldMap();
+    }
 }
 
 void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const PlayerColor color, const double armyStrength, const uint8_t skill )
@@ -657,57 +800,55 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const PlayerColor c
 
         processWorldMap();
     }
+    else if ( !_changedTiles.empty() ) {
+        repairWorldMap();
+    }
 }
 
 bool AIWorldPathfinder::isTileAccessibleForAI( const int tileIndex )
 {
-    std::optional<bool> & isAccessible = _cache[tileIndex]._isAccessibleForAI;
-    if ( !isAccessible ) {
-        isAccessible = isTileAccessibleForAIWithArmy( tileIndex, _armyStrength, _minimalArmyStrengthAdvantage );
+    const std::optional<bool> cachedValue = _cache.getAIProperty( tileIndex, WorldNodeCache::AIProperty::ACCESSIBLE );
+    if ( cachedValue ) {
+        return *cachedValue;
     }
 
-    return *isAccessible;
+    const bool isAccessible = isTileAccessibleForAIWithArmy( tileIndex, _armyStrength, _minimalArmyStrengthAdvantage );
+    _cache.setAIProperty( tileIndex, WorldNodeCache::AIProperty::ACCESSIBLE, isAccessible );
+
+    return isAccessible;
 }
 
 bool AIWorldPathfinder::isTileAvailableForWalkThroughForAI( const int tileIndex, const bool fromWater )
 {
-    std::optional<bool> & isAvailableForWalkThrough
-        = fromWater ? _cache[tileIndex]._isAvailableForWalkThroughForAI.fromWater : _cache[tileIndex]._isAvailableForWalkThroughForAI.fromLand;
-    if ( !isAvailableForWalkThrough ) {
-        isAvailableForWalkThrough = isTileAvailableForWalkThroughForAIWithArmy( tileIndex, fromWater, _color, _isArtifactsBagFull, _isEquippedWithSpellBook,
-                                                                                _armyStrength, _minimalArmyStrengthAdvantage );
+    const WorldNodeCache::AIProperty property
+        = fromWater ? WorldNodeCache::AIProperty::AVAILABLE_FOR_WALK_THROUGH_FROM_WATER : WorldNodeCache::AIProperty::AVAILABLE_FOR_WALK_THROUGH_FROM_LAND;
+
+    const std::optional<bool> cachedValue = _cache.getAIProperty( tileIndex, property );
+    if ( cachedValue ) {
+        return *cachedValue;
     }
 
-    return *isAvailableForWalkThrough;
+    const bool isAvailableForWalkThrough = isTileAvailableForWalkThroughForAIWithArmy( tileIndex, fromWater, _color, _isArtifactsBagFull, _isEquippedWithSpellBook,
+                                                                                       _armyStrength, _minimalArmyStrengthAdvantage );
+    _cache.setAIProperty( tileIndex, property, isAvailableForWalkThrough );
+
+    return isAvailableForWalkThrough;
 }
 
 void AIWorldPathfinder::processWorldMap()
 {
     assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
 
-    for ( WorldNode & node : _cache ) {
-        node = {};
-    }
+    _changedTiles.clear();
 
-    _cache[_pathStart].update( -1, 0, _remainingMovePoints );
+    _cache.clear();
+    _cache.update( _pathStart, -1, 0, _remainingMovePoints );
 
     std::vector<int> nodesToExplore;
     nodesToExplore.push_back( _pathStart );
 
-    const auto processTownPortal = [this, &nodesToExplore]( const Spell & spell, const int32_t castleIndex ) {
-        assert( castleIndex >= 0 && static_cast<size_t>( castleIndex ) < _cache.size() );
-        assert( castleIndex != _pathStart && _cache[castleIndex]._from == -1 );
-
-        const uint32_t cost = spell.movePoints();
-        const uint32_t remaining = ( _remainingMovePoints < cost ) ? 0 : _remainingMovePoints - cost;
-
-        _cache[castleIndex].update( _pathStart, cost, remaining );
-
-        nodesToExplore.push_back( castleIndex );
-    };
-
     if ( _townGateCastleIndex != -1 ) {
-        processTownPortal( Spell::TOWNGATE, _townGateCastleIndex );
+        processTownPortal( nodesToExplore, Spell::TOWNGATE, _townGateCastleIndex );
     }
 
     for ( const int32_t idx : _townPortalCastleIndexes ) {
@@ -715,7 +856,7 @@ void AIWorldPathfinder::processWorldMap()
             continue;
         }
 
-        processTownPortal( Spell::TOWNPORTAL, idx );
+        processTownPortal( nodesToExplore, Spell::TOWNPORTAL, idx );
     }
 
     for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
@@ -723,6 +864,48 @@ void AIWorldPathfinder::processWorldMap()
     }
 }
 
+void AIWorldPathfinder::processTownPortal( std::vector<int> & nodesToExplore, const Spell & spell, const int32_t castleIndex )
+{
+    assert( castleIndex >= 0 && static_cast<size_t>( castleIndex ) < _cache.size() );
+    assert( castleIndex != _pathStart && _cache.getFrom( castleIndex ) == -1 );
+
+    const uint32_t cost = spell.movePoints();
+    const uint32_t remaining = ( _remainingMovePoints < cost ) ? 0 : _remainingMovePoints - cost;
+
+    _cache.update( castleIndex, _pathStart, cost, remaining );
+
+    nodesToExplore.push_back( castleIndex );
+}
+
+void AIWorldPathfinder::addNonAdjacentRepairNodes( std::vector<int> & nodesToExplore, const std::vector<uint8_t> & isNodeInvalidated )
+{
+    if ( _townGateCastleIndex != -1 && isNodeInvalidated[_townGateCastleIndex] ) {
+        processTownPortal( nodesToExplore, Spell::TOWNGATE, _townGateCastleIndex );
+    }
+
+    for ( const int32_t idx : _townPortalCastleIndexes ) {
+        if ( idx == _townGateCastleIndex || !isNodeInvalidated[idx] ) {
+            continue;
+        }
+
+        processTownPortal( nodesToExplore, Spell::TOWNPORTAL, idx );
+    }
+
+    // Teleport endpoints may be invalidated, so all reachable teleports should be explored again
+    for ( size_t i = 0; i < _cache.size(); ++i ) {
+        const int nodeIdx = static_cast<int>( i );
+
+        if ( isNodeInvalidated[nodeIdx] || nodeIdx == _pathStart || _cache.getFrom( nodeIdx ) == -1 ) {
+            continue;
+        }
+
+        const MP2::MapObjectType objectType = world.getTile( nodeIdx ).getMainObjectType( false );
+        if ( objectType == MP2::OBJ_STONE_LITHS || objectType == MP2::OBJ_WHIRLPOOL ) {
+            nodesToExplore.push_back( nodeIdx );
+        }
+    }
+}
+
 bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction ) const
 {
     return isMovementAllowedForColor( from, direction, _color, false, _isSummonBoatSpellAvailable );
@@ -731,7 +914,6 @@ bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction )
 void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
-    WorldNode & currentNode = _cache[currentNodeIdx];
 
     // Always allow movement from the starting point to cover the edge case where we got here before this tile became blocked
     if ( !isFirstNode ) {
@@ -749,15 +931,15 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
 
         if ( !isTileAccessible ) {
             // If we can't move here, then reset the node
-            currentNode.reset();
+            _cache.reset( currentNodeIdx );
 
             return;
         }
 
         // No dead ends allowed
-        assert( currentNode._from != -1 );
+        assert( _cache.getFrom( currentNodeIdx ) != -1 );
 
-        const bool fromWater = world.getTile( currentNode._from ).isWater();
+        const bool fromWater = world.getTile( _cache.getFrom( currentNodeIdx ) ).isWater();
 
         if ( !isTileAvailableForWalkThroughForAI( currentNodeIdx, fromWater ) ) {
             return;
@@ -784,11 +966,9 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
                 continue;
             }
 
-            WorldNode & teleportNode = _cache[teleportIdx];
-
             // Check if the movement is really faster via teleport
-            if ( teleportNode._from == -1 || teleportNode._cost > currentNode._cost ) {
-                teleportNode.update( currentNodeIdx, currentNode._cost, currentNode._remainingMovePoints );
+            if ( _cache.getFrom( teleportIdx ) == -1 || _cache.getCost( teleportIdx ) > _cache.getCost( currentNodeIdx ) ) {
+                _cache.update( teleportIdx, currentNodeIdx, _cache.getCost( currentNodeIdx ), _cache.getRemainingMovePoints( currentNodeIdx ) );
 
                 nodesToExplore.push_back( teleportIdx );
             }
@@ -796,7 +976,7 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
 
         // Check adjacent nodes only if we are either not on the teleport tile, or we got here from another endpoint of this teleport.
         // Do not check them if we came to the tile with a teleport from a neighboring tile (and are going to use it for teleportation).
-        if ( !teleports.empty() && std::find( teleports.begin(), teleports.end(), currentNode._from ) == teleports.end() ) {
+        if ( !teleports.empty() && std::find( teleports.begin(), teleports.end(), _cache.getFrom( currentNodeIdx ) ) == teleports.end() ) {
             return;
         }
     }
@@ -825,12 +1005,12 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
             return regularPenalty;
         }
 
-        const WorldNode & node = _cache[from];
+        const int prevNodeIdx = _cache.getFrom( from );
 
         // No dead ends allowed
-        assert( node._from != -1 );
+        assert( prevNodeIdx != -1 );
 
-        const int prevStepDirection = Maps::GetDirection( node._from, from );
+        const int prevStepDirection = Maps::GetDirection( prevNodeIdx, from );
         assert( prevStepDirection != Direction::UNKNOWN && prevStepDirection != Direction::CENTER );
 
         // If we are moving from a tile that we technically cannot stand on, then it means that there was
@@ -846,7 +1026,7 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
         //
         // The real path will not reach this step, so this logic will be used to estimate distances more
         // accurately when choosing whether to move through objects or past them.
-        return regularPenalty + WorldPathfinder::getMovementPenalty( node._from, from, prevStepDirection );
+        return regularPenalty + WorldPathfinder::getMovementPenalty( prevNodeIdx, from, prevStepDirection );
     }();
 
     const uint32_t maxMovePoints = getMaxMovePoints( fromTile.isWater() );
@@ -855,10 +1035,8 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
     // If we perform pathfinding for a real AI-controlled hero on the map, we should correctly calculate
     // movement penalties when this hero overcomes water obstacles using boats.
     if ( maxMovePoints > 0 ) {
-        const WorldNode & node = _cache[from];
-
         // No dead ends allowed
-        assert( from == _pathStart || node._from != -1 );
+        assert( from == _pathStart || _cache.getFrom( from ) != -1 );
 
         const Maps::Tile & toTile = world.getTile( to );
 
@@ -870,11 +1048,13 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
         if ( isComesOnBoard || isDisembarks ) {
             // If the hero is not able to make this movement this turn, then he will have to spend
             // all the movement points next turn.
-            if ( defaultPenalty > node._remainingMovePoints ) {
+            const uint32_t remainingMovePoints = _cache.getRemainingMovePoints( from );
+
+            if ( defaultPenalty > remainingMovePoints ) {
                 return maxMovePoints;
             }
 
-            return node._remainingMovePoints;
+            return remainingMovePoints;
         }
     }
 
@@ -898,7 +1078,7 @@ std::pair<int32_t, bool> AIWorldPathfinder::getFogDiscoveryTile( const Heroes &
         TileCharacteristics bestTile;
 
         for ( size_t idx = 0; idx < _cache.size(); ++idx ) {
-            const uint32_t nodeCost = _cache[idx]._cost;
+            const uint32_t nodeCost = _cache.getCost( idx );
             if ( nodeCost == 0 ) {
                 continue;
             }
@@ -954,7 +1134,7 @@ std::pair<int32_t, bool> AIWorldPathfinder::getFogDiscoveryTile( const Heroes &
     // If we are unlucky, then we need to do the heavy lifting and consider the accessible tiles that have at least one neighboring tile that is inaccessible to the hero
     // (since there may be unexplored tiles covered with fog on the other side of such an obstacle).
     {
-        const int32_t bestTileIdx = findBestTile( [this]( const int32_t tileIdx ) { return _cache[tileIdx]._cost == 0; } );
+        const int32_t bestTileIdx = findBestTile( [this]( const int32_t tileIdx ) { return _cache.getCost( tileIdx ) == 0; } );
         if ( bestTileIdx != -1 ) {
             return { bestTileIdx, false };
         }
@@ -989,10 +1169,8 @@ int AIWorldPathfinder::getNearestTileToMove( const Heroes & hero )
             continue;
         }
 
-        const WorldNode & node = _cache[newIndex];
-
         // Tile is directly reachable (in one move) and the hero has enough army to defeat potential guards
-        if ( node._cost > 0 && node._from == start ) {
+        if ( _cache.getCost( newIndex ) > 0 && _cache.getFrom( newIndex ) == start ) {
             return newIndex;
         }
     }
@@ -1164,7 +1342,7 @@ std::vector<IndexObject> AIWorldPathfinder::getObjectsOnTheWay( const int target
     std::vector<IndexObject> result;
 
     // Destination is not reachable
-    if ( _cache[targetIndex]._cost == 0 ) {
+    if ( _cache.getCost( targetIndex ) == 0 ) {
         return result;
     }
 
@@ -1192,7 +1370,7 @@ std::vector<IndexObject> AIWorldPathfinder::getObjectsOnTheWay( const int target
     while ( currentNode != _pathStart ) {
         assert( currentNode != -1 );
 
-        const int from = _cache[currentNode]._from;
+        const int from = _cache.getFrom( currentNode );
 
         assert( from != -1 );
 
@@ -1343,7 +1521,7 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex ) con
     std::list<Route::Step> path;
 
     // Destination is not reachable
-    if ( _cache[targetIndex]._cost == 0 ) {
+    if ( _cache.getCost( targetIndex ) == 0 ) {
         return path;
     }
 
@@ -1363,18 +1541,18 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex ) con
             lastValidNode = currentNode;
         }
 
-        const WorldNode & node = _cache[currentNode];
+        const int from = _cache.getFrom( currentNode );
 
-        assert( node._from != -1 );
+        assert( from != -1 );
 
-        const uint32_t cost = node._cost - _cache[node._from]._cost;
+        const uint32_t cost = _cache.getCost( currentNode ) - _cache.getCost( from );
 
-        path.emplace_front( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
+        path.emplace_front( currentNode, from, Maps::GetDirection( from, currentNode ), cost );
 
         // The path should not pass through the same tile more than once
-        assert( uniqPathIndexes.insert( node._from ).second );
+        assert( uniqPathIndexes.insert( from ).second );
 
-        currentNode = node._from;
+        currentNode = from;
     }
 
     // Cut the path to the last valid tile/obstacle
@@ -1392,7 +1570,7 @@ uint32_t AIWorldPathfinder::getDistance( const int start, const int targetIndex,
 
     assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
 
-    return _cache[targetIndex]._cost;
+    return _cache.getCost( targetIndex );
 }
 
 void AIWorldPathfinder::setMinimalArmyStrengthAdvantage( const double advantage )
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <list>
 #include <optional>
@@ -31,44 +32,104 @@
 
 class Heroes;
 class IndexObject;
+class Spell;
 
 namespace Route
 {
     class Step;
 }
 
-struct WorldNode final
+// Pathfinder cache for all tiles of the World Map. The pathfinding mostly operates on the source node, the cost and the remaining
+// movement points of nodes, so each of these properties is stored in a separate array (structure of arrays) to reduce the memory
+// traffic during the map processing.
+class WorldNodeCache final
 {
-    int _from{ -1 };
-    uint32_t _cost{ 0 };
-    // The number of movement points remaining for the hero after moving to this node
-    uint32_t _remainingMovePoints{ 0 };
-
+public:
     // When calculating tile availability for an AI-controlled player, various relatively heavy computations are
     // performed, the result of which does not depend on the direction in which the tile is entered. The results
-    // of these calculations can be cached.
-    std::optional<bool> _isAccessibleForAI;
-    struct
+    // of these calculations can be cached. Each property is stored as a 2-bit tri-state value (unknown, false or
+    // true).
+    enum class AIProperty : uint8_t
+    {
+        ACCESSIBLE = 0,
+        AVAILABLE_FOR_WALK_THROUGH_FROM_WATER = 2,
+        AVAILABLE_FOR_WALK_THROUGH_FROM_LAND = 4
+    };
+
+    WorldNodeCache() = default;
+
+    size_t size() const
     {
-        std::optional<bool> fromWater;
-        std::optional<bool> fromLand;
-    } _isAvailableForWalkThroughForAI;
+        return _from.size();
+    }
+
+    // Resizes the cache and resets all nodes.
+    void resize( const size_t size );
 
-    WorldNode() = default;
+    // Resets all nodes including the cached AI-specific properties.
+    void clear();
 
-    void update( const int from, const uint32_t cost, const uint32_t remainingMovePoints )
+    // Resets the given node including its cached AI-specific properties.
+    void clearNode( const size_t nodeIdx )
     {
-        _from = from;
-        _cost = cost;
-        _remainingMovePoints = remainingMovePoints;
+        reset( nodeIdx );
+
+        _aiProperties[nodeIdx] = 0;
     }
 
-    void reset()
+    // Resets the path information of the given node, the cached AI-specific properties are preserved.
+    void reset( const size_t nodeIdx )
     {
-        _from = -1;
-        _cost = 0;
-        _remainingMovePoints = 0;
+        _from[nodeIdx] = -1;
+        _cost[nodeIdx] = 0;
+        _remainingMovePoints[nodeIdx] = 0;
     }
+
+    void update( const size_t nodeIdx, const int from, const uint32_t cost, const uint32_t remainingMovePoints )
+    {
+        _from[nodeIdx] = from;
+        _cost[nodeIdx] = cost;
+        _remainingMovePoints[nodeIdx] = remainingMovePoints;
+    }
+
+    int getFrom( const size_t nodeIdx ) const
+    {
+        return _from[nodeIdx];
+    }
+
+    uint32_t getCost( const size_t nodeIdx ) const
+    {
+        return _cost[nodeIdx];
+    }
+
+    // Returns the number of movement points remaining for the hero after moving to the given node.
+    uint32_t getRemainingMovePoints( const size_t nodeIdx ) const
+    {
+        return _remainingMovePoints[nodeIdx];
+    }
+
+    std::optional<bool> getAIProperty( const size_t nodeIdx, const AIProperty property ) const
+    {
+        const uint8_t value = ( _aiProperties[nodeIdx] >> static_cast<uint8_t>( property ) ) & 0x3;
+        if ( value == 0 ) {
+            return {};
+        }
+
+        return ( value & 0x1 ) != 0;
+    }
+
+    void setAIProperty( const size_t nodeIdx, const AIProperty property, const bool value )
+    {
+        const uint8_t shift = static_cast<uint8_t>( property );
+
+        _aiProperties[nodeIdx] = static_cast<uint8_t>( ( _aiProperties[nodeIdx] & ~( 0x3 << shift ) ) | ( ( value ? 0x3 : 0x2 ) << shift ) );
+    }
+
+private:
+    std::vector<int32_t> _from;
+    std::vector<uint32_t> _cost;
+    std::vector<uint32_t> _remainingMovePoints;
+    std::vector<uint8_t> _aiProperties;
 };
 
 // Abstract class that provides basic functionality for navigating the World Map
@@ -84,6 +145,11 @@ public:
 
     virtual void reset();
 
+    // Informs the pathfinder that the state of the given tile has been changed (for example, an object has been removed from
+    // this tile or the fog has been cleared). If the hero properties are not changed by the time of the next re-evaluation,
+    // then only the part of the cache that may depend on the changed tiles will be re-evaluated instead of the whole map.
+    void markTileAsChanged( const int32_t tileIndex );
+
     uint32_t getDistance( int targetIndex ) const;
 
 protected:
@@ -91,6 +157,14 @@ protected:
 
     virtual void processWorldMap();
 
+    // Re-evaluates only those nodes whose paths may be affected by the changes of tiles marked using markTileAsChanged(). The
+    // hero properties should remain the same since the last call of processWorldMap().
+    void repairWorldMap();
+
+    // Adds the nodes from which the invalidated nodes can be reached not only by moving to an adjacent tile (for example, using
+    // teleports) to the list of nodes that should be explored while repairing the cache. The default implementation does nothing.
+    virtual void addNonAdjacentRepairNodes( std::vector<int> & nodesToExplore, const std::vector<uint8_t> & isNodeInvalidated );
+
     // Checks whether moving from the source tile in the specified direction is allowed. The default implementation
     // can be overridden by a derived class.
     virtual bool isMovementAllowed( const int from, const int direction ) const;
@@ -109,9 +183,12 @@ protected:
     // overridden by a derived class.
     virtual uint32_t getMovementPenalty( const int from, const int to, const int direction ) const;
 
-    std::vector<WorldNode> _cache;
+    WorldNodeCache _cache;
     std::vector<int> _mapOffset;
 
+    // Indexes of tiles that have been changed since the last evaluation of the cache
+    std::vector<int32_t> _changedTiles;
+
     // The hero properties used by the pathfinder are cached here not just for optimization, but also because some
     // of them may change even if the position of the hero does not change, so it should be possible to compare the
     // old values with the new ones to determine whether the pathfinder cache needs to be recalculated.
@@ -226,6 +303,12 @@ private:
 
     void processWorldMap() override;
 
+    // Movement using Town Gate and Town Portal spells is possible only from the starting tile
+    void processTownPortal( std::vector<int> & nodesToExplore, const Spell & spell, const int32_t castleIndex );
+
+    // Restores the movement using Town Gate and Town Portal spells and adds teleports
+    void addNonAdjacentRepairNodes( std::vector<int> & nodesToExplore, const std::vector<uint8_t> & isNodeInvalidated ) override;
+
     // Adds special logic for AI-controlled heroes to use Summon Boat spell to overcome water obstacles (if available)
     bool isMovementAllowed( const int from, const int direction ) const override;
 
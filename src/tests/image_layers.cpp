@@ -0,0 +1,242 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+// Verifies that single-layer images produce the same image layer as double-layer images with a fully non-transparent transform layer.
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "image.h"
+
+namespace
+{
+    int failureCount = 0;
+
+    void check( const bool condition, const std::string & description )
+    {
+        if ( !condition ) {
+            std::cerr << "FAILED: " << description << std::endl;
+            ++failureCount;
+        }
+    }
+
+    bool isImageLayerEqual( const fheroes2::Image & first, const fheroes2::Image & second )
+    {
+        if ( first.width() != second.width() || first.height() != second.height() ) {
+            return false;
+        }
+
+        return memcmp( first.image(), second.image(), static_cast<size_t>( first.width() ) * first.height() ) == 0;
+    }
+
+    bool isTransformLayerOpaque( const fheroes2::Image & image )
+    {
+        const uint8_t * transform = image.transform();
+        const uint8_t * transformEnd = transform + static_cast<ptrdiff_t>( image.width() ) * image.height();
+
+        for ( ; transform != transformEnd; ++transform ) {
+            if ( *transform != 0 ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    fheroes2::Image makeImage( const int32_t width, const int32_t height, const bool isSingleLayer )
+    {
+        fheroes2::Image image;
+        if ( isSingleLayer ) {
+            image._disableTransformLayer();
+        }
+
+        image.resize( width, height );
+        image.fill( 0 );
+
+        return image;
+    }
+
+    // Makes a pair of images with identical image layers: a single-layer image and a double-layer image with no transparent pixels.
+    void makeOpaquePair( const int32_t width, const int32_t height, std::mt19937 & generator, fheroes2::Image & single, fheroes2::Image & twoLayer )
+    {
+        single = makeImage( width, height, true );
+        twoLayer = makeImage( width, height, false );
+
+        std::uniform_int_distribution<uint32_t> colorDistribution( 0, 255 );
+
+        const size_t size = static_cast<size_t>( width ) * height;
+        for ( size_t i = 0; i < size; ++i ) {
+            const uint8_t color = static_cast<uint8_t>( colorDistribution( generator ) );
+            single.image()[i] = color;
+            twoLayer.image()[i] = color;
+        }
+
+        memset( twoLayer.transform(), static_cast<uint8_t>( 0 ), size );
+    }
+
+    // Makes a double-layer sprite with a mix of opaque, transparent and shadow pixels.
+    fheroes2::Image makeSprite( const int32_t width, const int32_t height, std::mt19937 & generator )
+    {
+        fheroes2::Image sprite = makeImage( width, height, false );
+
+        std::uniform_int_distribution<uint32_t> colorDistribution( 0, 255 );
+        std::uniform_int_distribution<uint32_t> transformDistribution( 0, 7 );
+
+        const size_t size = static_cast<size_t>( width ) * height;
+        for ( size_t i = 0; i < size; ++i ) {
+            sprite.image()[i] = static_cast<uint8_t>( colorDistribution( generator ) );
+
+            // Keep long runs of opaque and transparent pixels so that both the per-pixel and the block processing code is covered.
+            const uint32_t value = transformDistribution( generator );
+            sprite.transform()[i] = static_cast<uint8_t>( value < 4 ? 0 : ( value < 7 ? 1 : 2 + value ) );
+        }
+
+        return sprite;
+    }
+
+    void testCopy( std::mt19937 & generator )
+    {
+        fheroes2::Image singleIn;
+        fheroes2::Image doubleIn;
+        makeOpaquePair( 37, 23, generator, singleIn, doubleIn );
+
+        for ( const bool isSingleLayerOut : { true, false } ) {
+            const std::string suffix = isSingleLayerOut ? " to a single-layer image" : " to a double-layer image";
+
+            fheroes2::Image fromSingle = makeImage( 0, 0, isSingleLayerOut );
+            fheroes2::Image fromDouble = makeImage( 0, 0, isSingleLayerOut );
+
+            fheroes2::Copy( singleIn, fromSingle );
+            fheroes2::Copy( doubleIn, fromDouble );
+
+            check( fromSingle.singleLayer() == isSingleLayerOut && fromDouble.singleLayer() == isSingleLayerOut, "Full Copy() keeps the layer mode" + suffix );
+            check( isImageLayerEqual( fromSingle, fromDouble ) && isImageLayerEqual( fromSingle, singleIn ), "Full Copy()" + suffix );
+
+            fromSingle = makeImage( 50, 40, isSingleLayerOut );
+            fromDouble = makeImage( 50, 40, isSingleLayerOut );
+
+            fheroes2::Copy( singleIn, 3, 2, fromSingle, 5, 7, 30, 20 );
+            fheroes2::Copy( doubleIn, 3, 2, fromDouble, 5, 7, 30, 20 );
+            check( isImageLayerEqual( fromSingle, fromDouble ), "Partial Copy()" + suffix );
+
+            if ( !isSingleLayerOut ) {
+                check( isTransformLayerOpaque( fromSingle ) && isTransformLayerOpaque( fromDouble ), "Copy() keeps the transform layer opaque" + suffix );
+            }
+        }
+
+        fheroes2::Image assigned;
+        assigned = singleIn;
+        check( assigned.singleLayer() && isImageLayerEqual( assigned, singleIn ), "Copy assignment of a single-layer image" );
+
+        fheroes2::Image moved( std::move( assigned ) );
+        check( moved.singleLayer() && isImageLayerEqual( moved, singleIn ), "Move construction of a single-layer image" );
+    }
+
+    void testBlit( std::mt19937 & generator )
+    {
+        // Widths below and above the transform block size are used to cover both row processing paths.
+        for ( const int32_t width : { 5, 16, 32, 77, 200 } ) {
+            fheroes2::Image singleIn;
+            fheroes2::Image doubleIn;
+            makeOpaquePair( width, 19, generator, singleIn, doubleIn );
+
+            const fheroes2::Image sprite = makeSprite( width, 19, generator );
+
+            fheroes2::Image singleBackground;
+            fheroes2::Image doubleBackground;
+            makeOpaquePair( width + 20, 40, generator, singleBackground, doubleBackground );
+
+            for ( const bool flip : { false, true } ) {
+                const std::string suffix = " (width " + std::to_string( width ) + ( flip ? ", flipped)" : ")" );
+
+                fheroes2::Image singleOut = singleBackground;
+                fheroes2::Image doubleOut = doubleBackground;
+
+                // Blit() does not support flipping of single-layer images so the double-layer image is used as an input for both outputs.
+                fheroes2::Blit( flip ? doubleIn : singleIn, singleOut, 7, 9, flip );
+                fheroes2::Blit( doubleIn, doubleOut, 7, 9, flip );
+                check( isImageLayerEqual( singleOut, doubleOut ), "Blit() of an opaque image" + suffix );
+                check( isTransformLayerOpaque( doubleOut ), "Blit() of an opaque image keeps the transform layer opaque" + suffix );
+
+                singleOut = singleBackground;
+                doubleOut = doubleBackground;
+
+                fheroes2::Blit( sprite, 1, 2, singleOut, 4, 3, width - 1, 15, flip );
+                fheroes2::Blit( sprite, 1, 2, doubleOut, 4, 3, width - 1, 15, flip );
+                check( isImageLayerEqual( singleOut, doubleOut ), "Blit() of a sprite with transparent and shadow pixels" + suffix );
+            }
+        }
+    }
+
+    void testResize( std::mt19937 & generator )
+    {
+        fheroes2::Image singleIn;
+        fheroes2::Image doubleIn;
+        makeOpaquePair( 41, 29, generator, singleIn, doubleIn );
+
+        for ( const bool isSingleLayerOut : { true, false } ) {
+            const std::string suffix = isSingleLayerOut ? " to a single-layer image" : " to a double-layer image";
+
+            for ( const int32_t scale : { 2, 3 } ) {
+                fheroes2::Image upscaledFromSingle = makeImage( 41 * scale, 29 * scale, isSingleLayerOut );
+                fheroes2::Image upscaledFromDouble = makeImage( 41 * scale, 29 * scale, isSingleLayerOut );
+
+                fheroes2::Resize( singleIn, upscaledFromSingle );
+                fheroes2::Resize( doubleIn, upscaledFromDouble );
+                check( isImageLayerEqual( upscaledFromSingle, upscaledFromDouble ), "Upscaling Resize()" + suffix );
+
+                fheroes2::Image downscaledFromSingle = makeImage( 41 / scale, 29 / scale, isSingleLayerOut );
+                fheroes2::Image downscaledFromDouble = makeImage( 41 / scale, 29 / scale, isSingleLayerOut );
+
+                fheroes2::Resize( singleIn, downscaledFromSingle );
+                fheroes2::Resize( doubleIn, downscaledFromDouble );
+                check( isImageLayerEqual( downscaledFromSingle, downscaledFromDouble ), "Downscaling Resize()" + suffix );
+
+                if ( !isSingleLayerOut ) {
+                    check( isTransformLayerOpaque( upscaledFromSingle ) && isTransformLayerOpaque( upscaledFromDouble )
+                               && isTransformLayerOpaque( downscaledFromSingle ) && isTransformLayerOpaque( downscaledFromDouble ),
+                           "Resize() keeps the transform layer opaque" + suffix );
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    // A fixed seed makes every run use the same images.
+    std::mt19937 generator( 12345 );
+
+    testCopy( generator );
+    testBlit( generator );
+    testResize( generator );
+
+    if ( failureCount > 0 ) {
+        std::cerr << failureCount << " check(s) failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "All checks passed." << std::endl;
+    return EXIT_SUCCESS;
+}
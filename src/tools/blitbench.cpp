@@ -0,0 +1,216 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "image.h"
+#include "system.h"
+#include "tools.h"
+
+namespace
+{
+    // Every operation is measured several times and the best time is used to reduce the noise.
+    constexpr int runCount = 5;
+
+    // Every operation is repeated until approximately this number of pixels is processed during a run.
+    constexpr int64_t pixelsPerRun = 1 << 24;
+
+    // Sizes of typical sprites: small icons, monster portraits, battle units and large interface elements.
+    const std::array<std::pair<int32_t, int32_t>, 4> spriteSizes = { { { 32, 32 }, { 64, 64 }, { 128, 128 }, { 320, 240 } } };
+
+    // The sprite is drawn in the middle of an image of the default resolution.
+    constexpr int32_t outputWidth = 640;
+    constexpr int32_t outputHeight = 480;
+
+    struct Operation
+    {
+        const char * name;
+        std::function<void( const fheroes2::Image &, fheroes2::Image & )> function;
+    };
+
+    // Creates a sprite which looks like a typical game sprite: an opaque ellipse with a shadow on a transparent background.
+    fheroes2::Image createSprite( const int32_t width, const int32_t height )
+    {
+        fheroes2::Image sprite( width, height );
+        sprite.reset();
+
+        uint8_t * image = sprite.image();
+        uint8_t * transform = sprite.transform();
+
+        const double radiusX = width / 2.0;
+        const double radiusY = height / 2.0;
+
+        for ( int32_t y = 0; y < height; ++y ) {
+            for ( int32_t x = 0; x < width; ++x ) {
+                const double dx = ( x + 0.5 - radiusX ) / radiusX;
+                const double dy = ( y + 0.5 - radiusY ) / radiusY;
+                const double distance = dx * dx + dy * dy;
+
+                const size_t offset = static_cast<size_t>( y ) * width + x;
+
+                if ( distance <= 0.8 ) {
+                    image[offset] = static_cast<uint8_t>( 10 + ( x * 7 + y * 13 ) % 200 );
+                    transform[offset] = 0;
+                }
+                else if ( distance <= 1.0 && dy > 0 ) {
+                    // Shadow below the ellipse
+                    transform[offset] = 3;
+                }
+            }
+        }
+
+        return sprite;
+    }
+
+    fheroes2::Image createOutput()
+    {
+        fheroes2::Image output( outputWidth, outputHeight );
+
+        uint8_t * image = output.image();
+        for ( int32_t i = 0; i < outputWidth * outputHeight; ++i ) {
+            image[i] = static_cast<uint8_t>( i % 251 );
+        }
+
+        std::fill_n( output.transform(), outputWidth * outputHeight, static_cast<uint8_t>( 0 ) );
+
+        return output;
+    }
+
+    double getElapsedMilliseconds( const std::chrono::steady_clock::time_point start )
+    {
+        return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+    }
+
+    // Returns the best time of a run in milliseconds. The output image after the last run is stored in 'result'.
+    double measure( const Operation & operation, const fheroes2::Image & sprite, fheroes2::Image & result )
+    {
+        const int64_t repeatCount = std::max<int64_t>( pixelsPerRun / ( static_cast<int64_t>( sprite.width() ) * sprite.height() ), 1 );
+
+        double bestTime = 0;
+
+        for ( int run = 0; run < runCount; ++run ) {
+            result = createOutput();
+
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            for ( int64_t i = 0; i < repeatCount; ++i ) {
+                operation.function( sprite, result );
+            }
+
+            const double time = getElapsedMilliseconds( start );
+
+            if ( run == 0 || time < bestTime ) {
+                bestTime = time;
+            }
+        }
+
+        return bestTime;
+    }
+
+    // Returns the checksum of both layers of the image to compare results of different builds.
+    uint32_t getChecksum( const fheroes2::Image & image )
+    {
+        const size_t size = static_cast<size_t>( image.width() ) * image.height();
+
+        return fheroes2::calculateCRC32( image.image(), size * 2 );
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    if ( argc > 1 ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " measures the performance of image drawing operations on typical sprites." << std::endl
+                  << "Build it from two revisions and compare their times. Equal checksums mean that both builds produce the same images." << std::endl
+                  << "Syntax: " << toolName << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<uint8_t> palette( 256 );
+    std::iota( palette.begin(), palette.end(), static_cast<uint8_t>( 0 ) );
+    std::reverse( palette.begin(), palette.end() );
+
+    const auto getOutputPosition = []( const fheroes2::Image & sprite ) {
+        return std::make_pair( ( outputWidth - sprite.width() ) / 2, ( outputHeight - sprite.height() ) / 2 );
+    };
+
+    const std::array<Operation, 6> operations = { {
+        { "Blit",
+          [&getOutputPosition]( const fheroes2::Image & in, fheroes2::Image & out ) {
+              const auto [x, y] = getOutputPosition( in );
+              fheroes2::Blit( in, out, x, y, false );
+          } },
+        { "Blit (flip)",
+          [&getOutputPosition]( const fheroes2::Image & in, fheroes2::Image & out ) {
+              const auto [x, y] = getOutputPosition( in );
+              fheroes2::Blit( in, out, x, y, true );
+          } },
+        { "AlphaBlit",
+          [&getOutputPosition]( const fheroes2::Image & in, fheroes2::Image & out ) {
+              const auto [x, y] = getOutputPosition( in );
+              fheroes2::AlphaBlit( in, out, x, y, 128, false );
+          } },
+        { "AlphaBlit (flip)",
+          [&getOutputPosition]( const fheroes2::Image & in, fheroes2::Image & out ) {
+              const auto [x, y] = getOutputPosition( in );
+              fheroes2::AlphaBlit( in, out, x, y, 128, true );
+          } },
+        { "ApplyPalette",
+          [&getOutputPosition, &palette]( const fheroes2::Image & in, fheroes2::Image & out ) {
+              const auto [x, y] = getOutputPosition( in );
+              fheroes2::ApplyPalette( in, 0, 0, out, x, y, in.width(), in.height(), palette );
+          } },
+        { "Copy",
+          [&getOutputPosition]( const fheroes2::Image & in, fheroes2::Image & out ) {
+              const auto [x, y] = getOutputPosition( in );
+              fheroes2::Copy( in, 0, 0, out, x, y, in.width(), in.height() );
+          } },
+    } };
+
+    for ( const auto & [width, height] : spriteSizes ) {
+        const fheroes2::Image sprite = createSprite( width, height );
+
+        std::cout << width << "x" << height << " sprite:" << std::endl;
+
+        for ( const Operation & operation : operations ) {
+            fheroes2::Image result;
+
+            const double time = measure( operation, sprite, result );
+
+            std::cout << "  " << std::left << std::setw( 18 ) << operation.name << std::right << std::fixed << std::setprecision( 2 ) << std::setw( 9 ) << time
+                      << " ms, checksum " << GetHexString( getChecksum( result ) ) << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -65,10 +65,11 @@ int main( int argc, char ** argv )
         fheroes2::setGamePalette( palette );
     }
 
-    fheroes2::Image image( 256, 256 );
-    image.reset();
+    fheroes2::Image image;
     // We do not need to care about the transform layer.
     image._disableTransformLayer();
+    image.resize( 256, 256 );
+    image.reset();
 
     // These color indexes are from PAL::GetCyclingPalette() method.
     const std::set<uint8_t> cyclingColors{ 214, 215, 216, 217, 218, 219, 220, 221, 231, 232, 233, 234, 235, 238, 239, 240, 241 };
@@ -0,0 +1,221 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "serialize.h"
+#include "system.h"
+#include "zzlib.h"
+
+namespace
+{
+    // Every compression level is measured several times and the best time is used to reduce the noise.
+    constexpr int runCount = 5;
+
+    // Size of the header of a zipped chunk, see Compression::zipStreamBuf() for details.
+    constexpr size_t zipChunkHeaderSize = 12;
+
+    const std::array<std::pair<Compression::Level, const char *>, 3> levels = { { { Compression::Level::FAST, "fast" },
+                                                                                   { Compression::Level::DEFAULT, "default" },
+                                                                                   { Compression::Level::BEST, "best" } } };
+
+    struct Result
+    {
+        size_t zipSize{ 0 };
+        double zipTime{ 0 };
+        double unzipTime{ 0 };
+    };
+
+    uint32_t getBE32( const std::vector<uint8_t> & data, const size_t offset )
+    {
+        return ( static_cast<uint32_t>( data[offset] ) << 24 ) | ( static_cast<uint32_t>( data[offset + 1] ) << 16 ) | ( static_cast<uint32_t>( data[offset + 2] ) << 8 )
+               | data[offset + 3];
+    }
+
+    // Save files end with a zipped chunk: its header contains the size of the zipped data which takes the rest of the file.
+    bool unzipSaveFileData( const std::vector<uint8_t> & data, std::vector<uint8_t> & rawData )
+    {
+        for ( size_t offset = 0; offset + zipChunkHeaderSize <= data.size(); ++offset ) {
+            if ( getBE32( data, offset + 4 ) != data.size() - offset - zipChunkHeaderSize ) {
+                continue;
+            }
+
+            ROStreamBuf inputStream( data.data() + offset, data.size() - offset );
+            inputStream.setBigendian( true );
+
+            RWStreamBuf outputStream;
+            if ( !Compression::unzipStream( inputStream, outputStream ) ) {
+                continue;
+            }
+
+            rawData = outputStream.getRaw( 0 );
+
+            return !rawData.empty();
+        }
+
+        return false;
+    }
+
+    // Map files (.fh2m) end with zlib data without any header.
+    bool unzipMapFileData( const std::vector<uint8_t> & data, std::vector<uint8_t> & rawData )
+    {
+        for ( size_t offset = 0; offset + 2 <= data.size(); ++offset ) {
+            // zlib data starts with the 0x78 byte (deflate with 32K window), and the first two bytes are a multiple of 31.
+            if ( data[offset] != 0x78 || ( ( static_cast<uint32_t>( data[offset] ) << 8 ) | data[offset + 1] ) % 31 != 0 ) {
+                continue;
+            }
+
+            rawData = Compression::unzipData( data.data() + offset, data.size() - offset );
+            if ( !rawData.empty() ) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    double getElapsedMilliseconds( const std::chrono::steady_clock::time_point start )
+    {
+        return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+    }
+
+    bool measure( const std::vector<uint8_t> & rawData, const Compression::Level level, Result & result )
+    {
+        result = {};
+
+        for ( int run = 0; run < runCount; ++run ) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            const std::vector<uint8_t> zipData = Compression::zipData( rawData.data(), rawData.size(), level );
+
+            const double zipTime = getElapsedMilliseconds( start );
+
+            start = std::chrono::steady_clock::now();
+
+            const std::vector<uint8_t> unzipData = Compression::unzipData( zipData.data(), zipData.size(), rawData.size() );
+
+            const double unzipTime = getElapsedMilliseconds( start );
+
+            if ( zipData.empty() || unzipData != rawData ) {
+                return false;
+            }
+
+            if ( run == 0 || zipTime < result.zipTime ) {
+                result.zipTime = zipTime;
+            }
+            if ( run == 0 || unzipTime < result.unzipTime ) {
+                result.unzipTime = unzipTime;
+            }
+
+            result.zipSize = zipData.size();
+        }
+
+        return true;
+    }
+
+    void printResult( const char * levelName, const size_t rawSize, const Result & result )
+    {
+        std::cout << "  " << std::left << std::setw( 8 ) << levelName << std::right << std::setw( 12 ) << result.zipSize << " bytes, ratio " << std::fixed
+                  << std::setprecision( 2 ) << std::setw( 6 ) << static_cast<double>( rawSize ) / static_cast<double>( std::max<size_t>( result.zipSize, 1 ) )
+                  << ", zip " << std::setprecision( 1 ) << std::setw( 8 ) << result.zipTime << " ms, unzip " << std::setw( 8 ) << result.unzipTime << " ms" << std::endl;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    if ( argc < 2 ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " compares the compression levels on the data of the specified save and map file(s)." << std::endl
+                  << "Syntax: " << toolName << " input_file ..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> inputFileNames;
+    for ( int i = 1; i < argc; ++i ) {
+        if ( System::isShellLevelGlobbingSupported() ) {
+            inputFileNames.emplace_back( argv[i] );
+        }
+        else {
+            System::globFiles( argv[i], inputFileNames );
+        }
+    }
+
+    size_t totalRawSize = 0;
+    std::array<Result, levels.size()> totalResults;
+
+    uint32_t filesProcessed = 0;
+
+    for ( const std::string & inputFileName : inputFileNames ) {
+        StreamFile inputStream;
+        if ( !inputStream.open( inputFileName, "rb" ) ) {
+            std::cerr << "Cannot open file " << inputFileName << std::endl;
+            // A non-existent or inaccessible file is not considered a fatal error
+            continue;
+        }
+
+        const std::vector<uint8_t> data = inputStream.getRaw( 0 );
+
+        std::vector<uint8_t> rawData;
+        if ( !unzipSaveFileData( data, rawData ) && !unzipMapFileData( data, rawData ) ) {
+            std::cerr << "File " << inputFileName << " does not contain zipped data" << std::endl;
+            continue;
+        }
+
+        std::cout << inputFileName << ": " << rawData.size() << " bytes of data" << std::endl;
+
+        for ( size_t i = 0; i < levels.size(); ++i ) {
+            Result result;
+            if ( !measure( rawData, levels[i].first, result ) ) {
+                std::cerr << "Error zipping the data of file " << inputFileName << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            printResult( levels[i].second, rawData.size(), result );
+
+            totalResults[i].zipSize += result.zipSize;
+            totalResults[i].zipTime += result.zipTime;
+            totalResults[i].unzipTime += result.unzipTime;
+        }
+
+        totalRawSize += rawData.size();
+
+        ++filesProcessed;
+    }
+
+    if ( filesProcessed > 1 ) {
+        std::cout << "Total: " << totalRawSize << " bytes of data in " << filesProcessed << " files" << std::endl;
+
+        for ( size_t i = 0; i < levels.size(); ++i ) {
+            printResult( levels[i].second, totalRawSize, totalResults[i] );
+        }
+    }
+
+    return ( filesProcessed > 0 ? EXIT_SUCCESS : EXIT_FAILURE );
+}